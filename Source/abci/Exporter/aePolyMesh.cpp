@@ -89,20 +89,17 @@ void aePolyMesh::writeSampleBody()
 {
     const auto &conf = getConfig();
 
-    // handle swap handedness
-    if (conf.swap_handedness)
+    // handle swap handedness and scale factor in one pass
+    float scale = conf.scale_factor;
+    if (conf.swap_handedness || scale != 1.0f)
     {
-        SwapHandedness(m_buf_points.data(), (int)m_buf_points.size());
-        SwapHandedness(m_buf_velocities.data(), (int)m_buf_velocities.size());
-        SwapHandedness(m_buf_normals.data(), (int)m_buf_normals.size());
+        abcV3 point_scale(conf.swap_handedness ? -scale : scale, scale, scale);
+        RemapTransform(m_buf_points.data(), m_buf_points.data(), nullptr, (int)m_buf_points.size(), point_scale);
+        RemapTransform(m_buf_velocities.data(), m_buf_velocities.data(), nullptr, (int)m_buf_velocities.size(), point_scale);
     }
-
-    // handle scale factor
-    float scale = conf.scale_factor;
-    if (scale != 1.0f)
+    if (conf.swap_handedness)
     {
-        ApplyScale(m_buf_points.data(), (int)m_buf_points.size(), scale);
-        ApplyScale(m_buf_velocities.data(), (int)m_buf_velocities.size(), scale);
+        SwapHandedness(m_buf_normals.data(), (int)m_buf_normals.size());
     }
 
     auto facecount = 0;
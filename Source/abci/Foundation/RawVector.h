@@ -118,7 +118,8 @@ public:
     {
         if (m_size == 0)
         {
-            deallocate(m_data, m_size);
+            deallocate(m_data, m_capacity);
+            m_data = nullptr;
             m_size = m_capacity = 0;
         }
         else if (m_size == m_capacity)
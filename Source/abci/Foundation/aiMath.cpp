@@ -12,6 +12,11 @@ void ApplyScaleISPC(abcV3 *dst, int num, float scale)
     ispc::Scale((float*)dst, num * 3, scale);
 }
 
+void RemapTransformISPC(abcV3 *dst, const abcV3 *src, const int *indices, int num, const abcV3& scale)
+{
+    ispc::RemapTransform((ispc::float3*)dst, (const ispc::float3*)src, indices, num, (const ispc::float3&)scale);
+}
+
 void NormalizeISPC(abcV3 *dst, int num)
 {
     ispc::Normalize((ispc::float3*)dst, num);
@@ -42,11 +47,37 @@ void GenerateVelocitiesISPC(abcV3 *dst, const abcV3 *p1, const abcV3 *p2, int nu
         (ispc::float3*)dst, (ispc::float3*)p1, (ispc::float3*)p2, num, motion_scale);
 }
 
+void LerpVerticesISPC(abcV3 *dst_points, abcV3 *dst_velocities, abcV3 *dst_normals,
+    const abcV3 *points1, const abcV3 *points2, const abcV3 *prev_points,
+    const abcV3 *normals1, const abcV3 *normals2, int num, float w, float motion_scale)
+{
+    ispc::LerpVertices(
+        (ispc::float3*)dst_points, (ispc::float3*)dst_velocities, (ispc::float3*)dst_normals,
+        (const ispc::float3*)points1, (const ispc::float3*)points2, (const ispc::float3*)prev_points,
+        (const ispc::float3*)normals1, (const ispc::float3*)normals2, num, w, motion_scale);
+}
+
 void MinMaxISPC(abcV3 & min, abcV3 & max, const abcV3 * points, int num)
 {
     ispc::MinMax3((ispc::float3&)min, (ispc::float3&)max, (const ispc::float3*)points, num);
 }
 
+void CopyMinMaxISPC(abcV3 *dst, abcV3& min, abcV3& max, const abcV3 *src, int num)
+{
+    ispc::CopyMinMax3((ispc::float3*)dst, (ispc::float3&)min, (ispc::float3&)max, (const ispc::float3*)src, num);
+}
+
+void RGBToRGBAISPC(abcC4 *dst, const abcC3 *src, int num)
+{
+    ispc::RGBToRGBA((ispc::float4*)dst, (const ispc::float3*)src, num);
+}
+
+void DequantizeDeltaISPC(abcV3 *dst, const uint16_t *src, const abcV3 *base, const abcV3& offset, const abcV3& step, int num)
+{
+    ispc::DequantizeDelta((ispc::float3*)dst, src, (const ispc::float3*)base,
+        (const ispc::float3&)offset, (const ispc::float3&)step, num);
+}
+
 
 void GenerateTangentsISPC(abcV4 *dst,
     const abcV3 *points, const abcV2 *uv, const abcV3 *normals, const int *indices,
@@ -56,12 +87,55 @@ void GenerateTangentsISPC(abcV4 *dst,
         (ispc::float4*)dst, (const ispc::float3*)points, (const ispc::float2*)uv, (const ispc::float3*)normals, indices, num_points, num_triangles);
 }
 
-void GeneratePointNormalsISPC(const int *face_start_offsets, const int *face_vertex_counts, const int *face_indices,
-    const float *positions, float *normals, const int *remapped_indices, const int face_count, const int remapped_count, const int orig_point_count)
+void GenerateCornerNormalsISPC(abcV3 *dst, const int *face_offsets, const int *tri_offsets, const int *triangles,
+    const int *indices, const abcV3 *points, int num_faces)
 {
-    std::vector<float> temp_normals(orig_point_count * 3, 0);
-    memset(normals, 0, remapped_count * 3 * sizeof(float));
-    ispc::GeneratePointNormals(face_start_offsets, face_vertex_counts, face_indices, positions, normals, remapped_indices, face_count, remapped_count, orig_point_count);
+    ispc::GenerateCornerNormals((ispc::float3*)dst, face_offsets, tri_offsets, triangles, indices,
+        (const ispc::float3*)points, num_faces);
+}
+
+void GatherPointNormalsISPC(abcV3 *dst, const abcV3 *corner_normals,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_indices, int num_points)
+{
+    ispc::GatherPointNormals((ispc::float3*)dst, (const ispc::float3*)corner_normals,
+        v2f_counts, v2f_offsets, v2f_indices, num_points);
+}
+
+void GenerateFaceNormalsISPC(abcV3 *dst, const int *tri_offsets, const int *triangles,
+    const int *indices, const abcV3 *points, int num_faces)
+{
+    ispc::GenerateFaceNormals((ispc::float3*)dst, tri_offsets, triangles, indices, (const ispc::float3*)points, num_faces);
+}
+
+void GenerateCornerNormalsAngleWeightedISPC(abcV3 *dst, const int *face_offsets, const abcV3 *face_normals,
+    const int *indices, const abcV3 *points, int num_faces)
+{
+    ispc::GenerateCornerNormalsAngleWeighted((ispc::float3*)dst, face_offsets, (const ispc::float3*)face_normals,
+        indices, (const ispc::float3*)points, num_faces);
+}
+
+void GatherSmoothedCornerNormalsISPC(abcV3 *dst, const abcV3 *corner_normals,
+    const abcV3 *face_normals, const int *face_offsets, const int *indices,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_faces, const int *v2f_indices,
+    float cos_threshold, int face_begin, int face_end)
+{
+    ispc::GatherSmoothedCornerNormals((ispc::float3*)dst, (const ispc::float3*)corner_normals,
+        (const ispc::float3*)face_normals, face_offsets, indices,
+        v2f_counts, v2f_offsets, v2f_faces, v2f_indices, cos_threshold, face_begin, face_end);
+}
+
+void GenerateCornerTangentsISPC(abcV4 *dst,
+    const abcV3 *points, const abcV2 *uv, const abcV3 *normals, const int *indices, int num_triangles)
+{
+    ispc::GenerateCornerTangents((ispc::float4*)dst, (const ispc::float3*)points, (const ispc::float2*)uv,
+        (const ispc::float3*)normals, indices, num_triangles);
+}
+
+void GatherVertexTangentsISPC(abcV4 *dst, const abcV4 *corner_tangents,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_indices, int num_points)
+{
+    ispc::GatherVertexTangents((ispc::float4*)dst, (const ispc::float4*)corner_tangents,
+        v2f_counts, v2f_offsets, v2f_indices, num_points);
 }
 
 #endif // aiEnableISPC
@@ -77,6 +151,26 @@ void ApplyScaleGeneric(abcV3 *dst, int num, float scale)
     }
 }
 
+void RemapTransformGeneric(abcV3 *dst, const abcV3 *src, const int *indices, int num, const abcV3& scale)
+{
+    if (indices)
+    {
+        for (int i = 0; i < num; ++i)
+        {
+            const abcV3& v = src[indices[i]];
+            dst[i] = abcV3(v.x * scale.x, v.y * scale.y, v.z * scale.z);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < num; ++i)
+        {
+            const abcV3& v = src[i];
+            dst[i] = abcV3(v.x * scale.x, v.y * scale.y, v.z * scale.z);
+        }
+    }
+}
+
 void LerpGeneric(float *dst, const float *v1, const float *v2, int num, float w)
 {
 	float iw = 1.0f - w;
@@ -130,6 +224,33 @@ void GenerateVelocitiesGeneric(abcV3 *dst, const abcV3 *p1, const abcV3 *p2, int
     }
 }
 
+void LerpVerticesGeneric(abcV3 *dst_points_, abcV3 *dst_velocities_, abcV3 *dst_normals_,
+    const abcV3 *points1_, const abcV3 *points2_, const abcV3 *prev_points_,
+    const abcV3 *normals1_, const abcV3 *normals2_, int num, float w, float motion_scale)
+{
+    auto *dst_points = (float3*)dst_points_;
+    auto *dst_velocities = (float3*)dst_velocities_;
+    auto *dst_normals = (float3*)dst_normals_;
+    auto *points1 = (const float3*)points1_;
+    auto *points2 = (const float3*)points2_;
+    auto *prev_points = (const float3*)prev_points_;
+    auto *normals1 = (const float3*)normals1_;
+    auto *normals2 = (const float3*)normals2_;
+    bool gen_velocities = dst_velocities && prev_points;
+    bool lerp_normals = dst_normals != nullptr;
+
+    float iw = 1.0f - w;
+    for (int i = 0; i < num; ++i)
+    {
+        float3 p = points1[i] * iw + points2[i] * w;
+        if (gen_velocities)
+            dst_velocities[i] = (prev_points[i] - p) * motion_scale;
+        dst_points[i] = p;
+        if (lerp_normals)
+            dst_normals[i] = normalize(normals1[i] * iw + normals2[i] * w);
+    }
+}
+
 void MinMaxGeneric(abcV3 &dst_min, abcV3 &dst_max, const abcV3 *src_, int num)
 {
     if (num == 0) { return; }
@@ -147,6 +268,80 @@ void MinMaxGeneric(abcV3 &dst_min, abcV3 &dst_max, const abcV3 *src_, int num)
     dst_max = (abcV3&)rmax;
 }
 
+void CopyMinMaxGeneric(abcV3 *dst_, abcV3& dst_min, abcV3& dst_max, const abcV3 *src_, int num)
+{
+    if (num == 0) { return; }
+
+    auto *dst = (float3*)dst_;
+    auto *src = (const float3*)src_;
+    auto rmin = src[0];
+    auto rmax = src[0];
+    for (int i = 0; i < num; ++i)
+    {
+        auto t = src[i];
+        dst[i] = t;
+        rmin = min(rmin, t);
+        rmax = max(rmax, t);
+    }
+    dst_min = (abcV3&)rmin;
+    dst_max = (abcV3&)rmax;
+}
+
+void RGBToRGBAGeneric(abcC4 *dst, const abcC3 *src, int num)
+{
+    for (int i = 0; i < num; ++i)
+    {
+        const abcC3& c = src[i];
+        dst[i] = abcC4(c.x, c.y, c.z, 1.0f);
+    }
+}
+
+void DequantizeDeltaGeneric(abcV3 *dst, const uint16_t *src, const abcV3 *base, const abcV3& offset, const abcV3& step, int num)
+{
+    for (int i = 0; i < num; ++i)
+    {
+        auto q = src + i * 3;
+        dst[i] = base[i] + offset + abcV3(q[0] * step.x, q[1] * step.y, q[2] * step.z);
+    }
+}
+
+void QuantizeDelta(uint16_t *dst, abcV3& offset, abcV3& step, const abcV3 *src, const abcV3 *base, int num)
+{
+    offset = step = abcV3(0.0f, 0.0f, 0.0f);
+    if (num == 0)
+        return;
+
+    abcV3 dmin = src[0] - base[0];
+    abcV3 dmax = dmin;
+    for (int i = 1; i < num; ++i)
+    {
+        abcV3 d = src[i] - base[i];
+        for (int c = 0; c < 3; ++c)
+        {
+            dmin[c] = std::min(dmin[c], d[c]);
+            dmax[c] = std::max(dmax[c], d[c]);
+        }
+    }
+
+    const float qmax = 65535.0f;
+    abcV3 rcp_step;
+    for (int c = 0; c < 3; ++c)
+    {
+        float range = dmax[c] - dmin[c];
+        step[c] = range / qmax;
+        rcp_step[c] = range > 0.0f ? qmax / range : 0.0f;
+    }
+    offset = dmin;
+
+    for (int i = 0; i < num; ++i)
+    {
+        abcV3 d = src[i] - base[i] - offset;
+        auto q = dst + i * 3;
+        for (int c = 0; c < 3; ++c)
+            q[c] = (uint16_t)std::min(d[c] * rcp_step[c] + 0.5f, qmax);
+    }
+}
+
 void GenerateTangentsGeneric(abcV4 *dst_,
     const abcV3 *points_, const abcV2 *uv_, const abcV3 *normals_, const int *indices,
     int num_points, int num_triangles)
@@ -184,35 +379,160 @@ void GenerateTangentsGeneric(abcV4 *dst_,
 }
 
 
-void GeneratePointNormalsGeneric(const int *face_start_offsets, const int *face_vertex_counts, const int *face_indices,
-    const float *positions, float *normals, const int *remapped_indices, const int face_count, const int remapped_count,
-    const int orig_point_count)
+void GenerateCornerNormalsGeneric(abcV3 *dst, const int *face_offsets, const int *tri_offsets, const int *triangles,
+    const int *indices, const abcV3 *points, int num_faces)
 {
+    for (int fi = 0; fi < num_faces; ++fi)
+    {
+        for (int c = face_offsets[fi]; c < face_offsets[fi + 1]; ++c)
+            dst[c] = abcV3(0.0f, 0.0f, 0.0f);
+        for (int ti = tri_offsets[fi]; ti < tri_offsets[fi + 1]; ++ti)
+        {
+            const int *tri = triangles + ti * 3;
+            const abcV3& p0 = points[indices[tri[0]]];
+            const abcV3& p1 = points[indices[tri[1]]];
+            const abcV3& p2 = points[indices[tri[2]]];
+            abcV3 n = (p2 - p0).cross(p1 - p0);
+            dst[tri[0]] += n;
+            dst[tri[1]] += n;
+            dst[tri[2]] += n;
+        }
+    }
+}
+
+void GatherPointNormalsGeneric(abcV3 *dst, const abcV3 *corner_normals,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_indices, int num_points)
+{
+    for (int vi = 0; vi < num_points; ++vi)
+    {
+        int count = v2f_counts[vi];
+        int offset = v2f_offsets[vi];
+        abcV3 n(0.0f, 0.0f, 0.0f);
+        for (int i = 0; i < count; ++i)
+            n += corner_normals[v2f_indices[offset + i]];
+        dst[vi] = n.normalize();
+    }
+}
 
-    std::vector<abcV3> tmp_normals(orig_point_count, {0.f, 0.f, 0.f});
-    for (size_t i = 0; i < face_count; ++i) {
-        int face_vert_count = face_vertex_counts[i];
-        int face_start_index = face_start_offsets[i];
-        if (face_vert_count < 3) {
-            continue;
+void GenerateFaceNormalsGeneric(abcV3 *dst, const int *tri_offsets, const int *triangles,
+    const int *indices, const abcV3 *points, int num_faces)
+{
+    for (int fi = 0; fi < num_faces; ++fi)
+    {
+        abcV3 n(0.0f, 0.0f, 0.0f);
+        for (int ti = tri_offsets[fi]; ti < tri_offsets[fi + 1]; ++ti)
+        {
+            const int *tri = triangles + ti * 3;
+            const abcV3& p0 = points[indices[tri[0]]];
+            n += (points[indices[tri[2]]] - p0).cross(points[indices[tri[1]]] - p0);
         }
-        for (int tri = 0; tri < face_vert_count - 2; ++tri) {
-            int i1 = face_indices[face_start_index + tri];
-            int i2 = face_indices[face_start_index + tri + 1];
-            int i3 = face_indices[face_start_index + tri + 2];
-            abcV3 p1 = reinterpret_cast<const abcV3*>(positions)[i1];
-            abcV3 p2 = reinterpret_cast<const abcV3*>(positions)[i2];
-            abcV3 p3 = reinterpret_cast<const abcV3*>(positions)[i3];
-            abcV3 tri_normal = (p3 - p1).cross(p2 - p1);
-            tmp_normals[i1] += tri_normal;
-            tmp_normals[i2] += tri_normal;
-            tmp_normals[i3] += tri_normal;
+        dst[fi] = n.normalize();
+    }
+}
+
+void GenerateCornerNormalsAngleWeightedGeneric(abcV3 *dst, const int *face_offsets, const abcV3 *face_normals,
+    const int *indices, const abcV3 *points, int num_faces)
+{
+    for (int fi = 0; fi < num_faces; ++fi)
+    {
+        int cbegin = face_offsets[fi];
+        int cend = face_offsets[fi + 1];
+        for (int c = cbegin; c < cend; ++c)
+        {
+            int cprev = c == cbegin ? cend - 1 : c - 1;
+            int cnext = c + 1 == cend ? cbegin : c + 1;
+            const abcV3& p = points[indices[c]];
+            abcV3 e1 = (points[indices[cprev]] - p).normalize();
+            abcV3 e2 = (points[indices[cnext]] - p).normalize();
+            float angle = std::acos(clamp(e1.dot(e2), -1.0f, 1.0f));
+            dst[c] = face_normals[fi] * angle;
+        }
+    }
+}
+
+void GatherSmoothedCornerNormalsGeneric(abcV3 *dst, const abcV3 *corner_normals,
+    const abcV3 *face_normals, const int *face_offsets, const int *indices,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_faces, const int *v2f_indices,
+    float cos_threshold, int face_begin, int face_end)
+{
+    for (int fi = face_begin; fi < face_end; ++fi)
+    {
+        const abcV3& fn = face_normals[fi];
+        for (int c = face_offsets[fi]; c < face_offsets[fi + 1]; ++c)
+        {
+            int vi = indices[c];
+            int count = v2f_counts[vi];
+            int offset = v2f_offsets[vi];
+            abcV3 n(0.0f, 0.0f, 0.0f);
+            for (int i = 0; i < count; ++i)
+            {
+                int ci = v2f_indices[offset + i];
+                if (ci == c || face_normals[v2f_faces[offset + i]].dot(fn) >= cos_threshold)
+                    n += corner_normals[ci];
+            }
+            dst[c] = n.normalize();
+        }
+    }
+}
+
+void GenerateCornerTangentsGeneric(abcV4 *dst,
+    const abcV3 *points, const abcV2 *uv, const abcV3 *normals, const int *indices, int num_triangles)
+{
+    for (int ti = 0; ti < num_triangles; ++ti)
+    {
+        const int *idx = indices + ti * 3;
+        abcV3 p[3] = { points[idx[0]], points[idx[1]], points[idx[2]] };
+        abcV2 t21 = uv[idx[1]] - uv[idx[0]];
+        abcV2 t31 = uv[idx[2]] - uv[idx[0]];
+        float area = t21.x * t31.y - t21.y * t31.x;
+        float orient = area > 0.0f ? 1.0f : -1.0f;
+
+        abcV3 os = (p[1] - p[0]) * t31.y - (p[2] - p[0]) * t21.y;
+        float los = os.length();
+        if (area != 0.0f && los > 0.0f)
+            os *= orient / los;
+
+        bool degenerate = p[0] == p[1] || p[1] == p[2] || p[2] == p[0];
+        for (int c = 0; c < 3; ++c)
+        {
+            abcV4& r = dst[ti * 3 + c];
+            if (degenerate)
+            {
+                r = abcV4(0.0f, 0.0f, 0.0f, 0.0f);
+                continue;
+            }
+            const abcV3& n = normals[idx[c]];
+            abcV3 t = (os - n * n.dot(os)).normalize();
+            abcV3 v1 = p[(c + 2) % 3] - p[c];
+            abcV3 v2 = p[(c + 1) % 3] - p[c];
+            v1 = (v1 - n * n.dot(v1)).normalize();
+            v2 = (v2 - n * n.dot(v2)).normalize();
+            float angle = std::acos(clamp(v1.dot(v2), -1.0f, 1.0f));
+            r = abcV4(t.x * angle, t.y * angle, t.z * angle, orient * angle);
         }
     }
-    for (size_t i = 0; i < remapped_count; ++i) {
-        int remap = remapped_indices[i];
-        abcV3 n = tmp_normals[remap].normalize();
-        reinterpret_cast<abcV3*>(normals)[i] = abcV3{ -n.x, n.y, n.z};
+}
+
+void GatherVertexTangentsGeneric(abcV4 *dst, const abcV4 *corner_tangents,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_indices, int num_points)
+{
+    for (int vi = 0; vi < num_points; ++vi)
+    {
+        int count = v2f_counts[vi];
+        int offset = v2f_offsets[vi];
+        abcV3 t(0.0f, 0.0f, 0.0f);
+        float w = 0.0f;
+        for (int i = 0; i < count; ++i)
+        {
+            const abcV4& ct = corner_tangents[v2f_indices[offset + i]];
+            t += abcV3(ct.x, ct.y, ct.z);
+            w += ct.w;
+        }
+        if (t.length2() > 0.0f)
+            t.normalize();
+        else
+            t = abcV3(1.0f, 0.0f, 0.0f);
+        dst[vi] = abcV4(t.x, t.y, t.z, w < 0.0f ? -1.0f : 1.0f);
     }
 }
 
@@ -247,6 +567,11 @@ void ApplyScale(abcV3 *dst, int num, float scale)
     Impl(ApplyScale, dst, num, scale);
 }
 
+void RemapTransform(abcV3 *dst, const abcV3 *src, const int *indices, int num, const abcV3& scale)
+{
+    Impl(RemapTransform, dst, src, indices, num, scale);
+}
+
 void Normalize(abcV3 *dst, int num)
 {
     Impl(Normalize, dst, num);
@@ -277,11 +602,34 @@ void GenerateVelocities(abcV3 *dst, const abcV3 *p1, const abcV3 *p2, int num, f
     Impl(GenerateVelocities, dst, p1, p2, num, motion_scale);
 }
 
+void LerpVertices(abcV3 *dst_points, abcV3 *dst_velocities, abcV3 *dst_normals,
+    const abcV3 *points1, const abcV3 *points2, const abcV3 *prev_points,
+    const abcV3 *normals1, const abcV3 *normals2, int num, float w, float motion_scale)
+{
+    Impl(LerpVertices, dst_points, dst_velocities, dst_normals,
+        points1, points2, prev_points, normals1, normals2, num, w, motion_scale);
+}
+
 void MinMax(abcV3 &min, abcV3 &max, const abcV3 *points, int num)
 {
     Impl(MinMax, min, max, points, num);
 }
 
+void CopyMinMax(abcV3 *dst, abcV3 &min, abcV3 &max, const abcV3 *src, int num)
+{
+    Impl(CopyMinMax, dst, min, max, src, num);
+}
+
+void RGBToRGBA(abcC4 *dst, const abcC3 *src, int num)
+{
+    Impl(RGBToRGBA, dst, src, num);
+}
+
+void DequantizeDelta(abcV3 *dst, const uint16_t *src, const abcV3 *base, const abcV3& offset, const abcV3& step, int num)
+{
+    Impl(DequantizeDelta, dst, src, base, offset, step, num);
+}
+
 void GenerateTangents(abcV4 *dst,
     const abcV3 *points, const abcV2 *uv, const abcV3 *normals, const int *indices,
     int num_points, int num_triangles)
@@ -289,15 +637,49 @@ void GenerateTangents(abcV4 *dst,
     Impl(GenerateTangents, dst, points, uv, normals, indices, num_points, num_triangles);
 }
 
-void GeneratePointNormals(const int *face_vertex_counts, const int *face_indices, const abcV3 *points, abcV3 *normals,
-        const int *remapped_point_indices, const int face_count, const int remapped_count, const int orig_point_count)
+void GenerateCornerNormals(abcV3 *dst, const int *face_offsets, const int *tri_offsets, const int *triangles,
+    const int *indices, const abcV3 *points, int num_faces)
+{
+    Impl(GenerateCornerNormals, dst, face_offsets, tri_offsets, triangles, indices, points, num_faces);
+}
+
+void GatherPointNormals(abcV3 *dst, const abcV3 *corner_normals,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_indices, int num_points)
+{
+    Impl(GatherPointNormals, dst, corner_normals, v2f_counts, v2f_offsets, v2f_indices, num_points);
+}
+
+void GenerateFaceNormals(abcV3 *dst, const int *tri_offsets, const int *triangles,
+    const int *indices, const abcV3 *points, int num_faces)
+{
+    Impl(GenerateFaceNormals, dst, tri_offsets, triangles, indices, points, num_faces);
+}
+
+void GenerateCornerNormalsAngleWeighted(abcV3 *dst, const int *face_offsets, const abcV3 *face_normals,
+    const int *indices, const abcV3 *points, int num_faces)
+{
+    Impl(GenerateCornerNormalsAngleWeighted, dst, face_offsets, face_normals, indices, points, num_faces);
+}
+
+void GatherSmoothedCornerNormals(abcV3 *dst, const abcV3 *corner_normals,
+    const abcV3 *face_normals, const int *face_offsets, const int *indices,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_faces, const int *v2f_indices,
+    float cos_threshold, int face_begin, int face_end)
+{
+    Impl(GatherSmoothedCornerNormals, dst, corner_normals, face_normals, face_offsets, indices,
+        v2f_counts, v2f_offsets, v2f_faces, v2f_indices, cos_threshold, face_begin, face_end);
+}
+
+void GenerateCornerTangents(abcV4 *dst,
+    const abcV3 *points, const abcV2 *uv, const abcV3 *normals, const int *indices, int num_triangles)
+{
+    Impl(GenerateCornerTangents, dst, points, uv, normals, indices, num_triangles);
+}
+
+void GatherVertexTangents(abcV4 *dst, const abcV4 *corner_tangents,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_indices, int num_points)
 {
-    std::vector<int> face_start_indices(face_count);
-    std::partial_sum(face_vertex_counts, face_vertex_counts + face_count - 1, face_start_indices.begin() + 1);
-    memset(normals, 0, remapped_count * 3 * sizeof(float));
-    Impl(GeneratePointNormals, face_start_indices.data(), face_vertex_counts, face_indices,
-            reinterpret_cast<const float*>(points), reinterpret_cast<float*>(normals),
-            remapped_point_indices, face_count, remapped_count, orig_point_count);
+    Impl(GatherVertexTangents, dst, corner_tangents, v2f_counts, v2f_offsets, v2f_indices, num_points);
 }
 
 #undef Impl
@@ -1424,6 +1424,9 @@ template<class T> inline tvec4<T> orthogonalize_tangent(
 void SwapHandedness(abcV3 *dst, int num);
 void SwapHandedness(abcV4 *dst, int num);
 void ApplyScale(abcV3 *dst, int num, float scale);
+// fused gather + handedness swap + scale: dst[i] = src[indices[i]] * scale (component-wise).
+// indices can be null for a straight in-place or out-of-place transform. pass scale.x < 0 to swap handedness.
+void RemapTransform(abcV3 *dst, const abcV3 *src, const int *indices, int num, const abcV3& scale);
 void Normalize(abcV3 *dst, int num);
 void Lerp(float *dst, const float *v1, const float *v2, int num, float w);
 void Lerp(abcV2 *dst, const abcV2 *v1, const abcV2 *v2, int num, float w);
@@ -1431,13 +1434,52 @@ void Lerp(abcV3 *dst, const abcV3 *v1, const abcV3 *v2, int num, float w);
 void Lerp(abcC4 *dst, const abcC4 *v1, const abcC4 *v2, int num, float w);
 void GenerateVelocities(abcV3 *dst, const abcV3 *p1, const abcV3 *p2, int num, float motion_scale);
 void MinMax(abcV3& min, abcV3& max, const abcV3 *points, int num);
+// copy + MinMax in one pass
+void CopyMinMax(abcV3 *dst, abcV3& min, abcV3& max, const abcV3 *src, int num);
+void RGBToRGBA(abcC4 *dst, const abcC3 *src, int num);
+// fused lerp of points + velocities + normals in one pass. see LerpVertices in aiSIMD.ispc.
+// dst_velocities / prev_points and dst_normals / normals1 / normals2 can be null to skip the stream.
+// prev_points can be the same as dst_points.
+void LerpVertices(abcV3 *dst_points, abcV3 *dst_velocities, abcV3 *dst_normals,
+    const abcV3 *points1, const abcV3 *points2, const abcV3 *prev_points,
+    const abcV3 *normals1, const abcV3 *normals2, int num, float w, float motion_scale);
+
+// lossy compression of points: dst (num * 3) = 16 bit quantized (src - base) within the bounds of the deltas.
+// DequantizeDelta() reconstructs dst = base + offset + q * step.
+void QuantizeDelta(uint16_t *dst, abcV3& offset, abcV3& step, const abcV3 *src, const abcV3 *base, int num);
+void DequantizeDelta(abcV3 *dst, const uint16_t *src, const abcV3 *base, const abcV3& offset, const abcV3& step, int num);
 void GenerateTangents(abcV4 *dst,
     const abcV3 *points, const abcV2 *uv, const abcV3 *normals, const int *indices,
     int num_points, int num_triangles);
+// point normals in two passes (see PointNormalsGenerator in aiMeshOps.h):
+// area weighted corner normals per face, then a per point gather of its corners through the vertex to face lists.
+void GenerateCornerNormals(abcV3 *dst, const int *face_offsets, const int *tri_offsets, const int *triangles,
+    const int *indices, const abcV3 *points, int num_faces);
+void GatherPointNormals(abcV3 *dst, const abcV3 *corner_normals,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_indices, int num_points);
+// for angle weighting and hard edges: unit face normals, corner normals weighted by the polygon angle, and
+// per corner gathers that skip faces beyond the smoothing angle. the gather takes an absolute face range because it
+// looks up the normals of neighbor faces, which can be in any range.
+void GenerateFaceNormals(abcV3 *dst, const int *tri_offsets, const int *triangles,
+    const int *indices, const abcV3 *points, int num_faces);
+void GenerateCornerNormalsAngleWeighted(abcV3 *dst, const int *face_offsets, const abcV3 *face_normals,
+    const int *indices, const abcV3 *points, int num_faces);
+void GatherSmoothedCornerNormals(abcV3 *dst, const abcV3 *corner_normals,
+    const abcV3 *face_normals, const int *face_offsets, const int *indices,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_faces, const int *v2f_indices,
+    float cos_threshold, int face_begin, int face_end);
+// MikkTSpace compatible tangents in two passes (see MikkTangentsGenerator in aiMeshOps.h):
+// angle weighted corner tangents per triangle, then a per vertex gather of its corners.
+void GenerateCornerTangents(abcV4 *dst,
+    const abcV3 *points, const abcV2 *uv, const abcV3 *normals, const int *indices, int num_triangles);
+void GatherVertexTangents(abcV4 *dst, const abcV4 *corner_tangents,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_indices, int num_points);
 
 // for test and debug
 void ApplyScaleGeneric(abcV3 *dst, int num, float scale);
 void ApplyScaleISPC(abcV3 *dst, int num, float scale);
+void RemapTransformGeneric(abcV3 *dst, const abcV3 *src, const int *indices, int num, const abcV3& scale);
+void RemapTransformISPC(abcV3 *dst, const abcV3 *src, const int *indices, int num, const abcV3& scale);
 void NormalizeGeneric(abcV3 *dst, int num);
 void NormalizeISPC(abcV3 *dst, int num);
 void LerpGeneric(abcV2 *dst, const abcV2 *v1, const abcV2 *v2, int num, float w);
@@ -1448,19 +1490,55 @@ void LerpISPC(abcV3 *dst, const abcV3 *v1, const abcV3 *v2, int num, float w);
 void LerpISPC(abcC4 *dst, const abcC4 *v1, const abcC4 *v2, int num, float w);
 void GenerateVelocitiesGeneric(abcV3 *dst, const abcV3 *p1, const abcV3 *p2, int num, float motion_scale);
 void GenerateVelocitiesISPC(abcV3 *dst, const abcV3 *p1, const abcV3 *p2, int num, float motion_scale);
+void LerpVerticesGeneric(abcV3 *dst_points, abcV3 *dst_velocities, abcV3 *dst_normals,
+    const abcV3 *points1, const abcV3 *points2, const abcV3 *prev_points,
+    const abcV3 *normals1, const abcV3 *normals2, int num, float w, float motion_scale);
+void LerpVerticesISPC(abcV3 *dst_points, abcV3 *dst_velocities, abcV3 *dst_normals,
+    const abcV3 *points1, const abcV3 *points2, const abcV3 *prev_points,
+    const abcV3 *normals1, const abcV3 *normals2, int num, float w, float motion_scale);
 void MinMaxGeneric(abcV3& min, abcV3& max, const abcV3 *points, int num);
 void MinMaxISPC(abcV3& min, abcV3& max, const abcV3 *points, int num);
+void CopyMinMaxGeneric(abcV3 *dst, abcV3& min, abcV3& max, const abcV3 *src, int num);
+void CopyMinMaxISPC(abcV3 *dst, abcV3& min, abcV3& max, const abcV3 *src, int num);
+void RGBToRGBAGeneric(abcC4 *dst, const abcC3 *src, int num);
+void RGBToRGBAISPC(abcC4 *dst, const abcC3 *src, int num);
+void DequantizeDeltaGeneric(abcV3 *dst, const uint16_t *src, const abcV3 *base, const abcV3& offset, const abcV3& step, int num);
+void DequantizeDeltaISPC(abcV3 *dst, const uint16_t *src, const abcV3 *base, const abcV3& offset, const abcV3& step, int num);
 void GenerateTangentsGeneric(abcV4 *dst,
     const abcV3 *points, const abcV2 *uv, const abcV3 *normals, const int *indices,
     int num_points, int num_triangles);
 void GenerateTangentsISPC(abcV4 *dst,
     const abcV3 *points, const abcV2 *uv, const abcV3 *normals, const int *indices,
     int num_points, int num_triangles);
-void GeneratePointNormals(const int *face_vertex_counts, const int *face_indices, const abcV3 *points, abcV3 *normals,
-    const int *remapped_point_indices, const int face_count, const int remapped_count, const int orig_point_count);
-void GeneratePointNormalsGeneric(const int *face_start_offsets, const int *face_vertex_counts, const int *face_indices,
-    const float *positions, float *normals, const int *remapped_points, const int face_count, const int remapped_count,
-    const int orig_point_count);
-void GeneratePointNormalsISPC(const int *face_start_offsets, const int *face_vertex_counts, const int *face_indices,
-    const float *positions, float *normals, const int *remapped_points, const int face_count, const int remapped_count,
-    const int orig_point_count);
+void GenerateCornerNormalsGeneric(abcV3 *dst, const int *face_offsets, const int *tri_offsets, const int *triangles,
+    const int *indices, const abcV3 *points, int num_faces);
+void GenerateCornerNormalsISPC(abcV3 *dst, const int *face_offsets, const int *tri_offsets, const int *triangles,
+    const int *indices, const abcV3 *points, int num_faces);
+void GatherPointNormalsGeneric(abcV3 *dst, const abcV3 *corner_normals,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_indices, int num_points);
+void GatherPointNormalsISPC(abcV3 *dst, const abcV3 *corner_normals,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_indices, int num_points);
+void GenerateFaceNormalsGeneric(abcV3 *dst, const int *tri_offsets, const int *triangles,
+    const int *indices, const abcV3 *points, int num_faces);
+void GenerateCornerNormalsAngleWeightedGeneric(abcV3 *dst, const int *face_offsets, const abcV3 *face_normals,
+    const int *indices, const abcV3 *points, int num_faces);
+void GatherSmoothedCornerNormalsGeneric(abcV3 *dst, const abcV3 *corner_normals,
+    const abcV3 *face_normals, const int *face_offsets, const int *indices,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_faces, const int *v2f_indices,
+    float cos_threshold, int face_begin, int face_end);
+void GenerateFaceNormalsISPC(abcV3 *dst, const int *tri_offsets, const int *triangles,
+    const int *indices, const abcV3 *points, int num_faces);
+void GenerateCornerNormalsAngleWeightedISPC(abcV3 *dst, const int *face_offsets, const abcV3 *face_normals,
+    const int *indices, const abcV3 *points, int num_faces);
+void GatherSmoothedCornerNormalsISPC(abcV3 *dst, const abcV3 *corner_normals,
+    const abcV3 *face_normals, const int *face_offsets, const int *indices,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_faces, const int *v2f_indices,
+    float cos_threshold, int face_begin, int face_end);
+void GenerateCornerTangentsGeneric(abcV4 *dst,
+    const abcV3 *points, const abcV2 *uv, const abcV3 *normals, const int *indices, int num_triangles);
+void GatherVertexTangentsGeneric(abcV4 *dst, const abcV4 *corner_tangents,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_indices, int num_points);
+void GenerateCornerTangentsISPC(abcV4 *dst,
+    const abcV3 *points, const abcV2 *uv, const abcV3 *normals, const int *indices, int num_triangles);
+void GatherVertexTangentsISPC(abcV4 *dst, const abcV4 *corner_tangents,
+    const int *v2f_counts, const int *v2f_offsets, const int *v2f_indices, int num_points);
@@ -3,60 +3,6 @@
 #include <unordered_set>
 
 
-namespace impl
-{
-    template<class Indices, class Counts>
-    inline void BuildConnection(
-        MeshConnectionInfo& connection, const Indices& indices, const Counts& counts, const IArray<float3>& vertices)
-    {
-        size_t num_points = vertices.size();
-        size_t num_faces = counts.size();
-        size_t num_indices = indices.size();
-
-        connection.v2f_offsets.resize_discard(num_points);
-        connection.v2f_faces.resize_discard(num_indices);
-        connection.v2f_indices.resize_discard(num_indices);
-
-        connection.v2f_counts.resize_zeroclear(num_points);
-        {
-            int ii = 0;
-            for (size_t fi = 0; fi < num_faces; ++fi)
-            {
-                int c = counts[fi];
-                for (int ci = 0; ci < c; ++ci)
-                {
-                    connection.v2f_counts[indices[ii + ci]]++;
-                }
-                ii += c;
-            }
-
-            int offset = 0;
-            for (size_t i = 0; i < num_points; ++i)
-            {
-                connection.v2f_offsets[i] = offset;
-                offset += connection.v2f_counts[i];
-            }
-        }
-
-        connection.v2f_counts.zeroclear();
-        {
-            int i = 0;
-            for (int fi = 0; fi < (int)num_faces; ++fi)
-            {
-                int c = counts[fi];
-                for (int ci = 0; ci < c; ++ci)
-                {
-                    int vi = indices[i + ci];
-                    int ti = connection.v2f_offsets[vi] + connection.v2f_counts[vi]++;
-                    connection.v2f_faces[ti] = fi;
-                    connection.v2f_indices[ti] = i + ci;
-                }
-                i += c;
-            }
-        }
-    }
-}
-
 void MeshConnectionInfo::clear()
 {
     v2f_counts.clear();
@@ -73,51 +19,119 @@ void MeshConnectionInfo::clear()
 void MeshConnectionInfo::buildConnection(
     const IArray<int>& indices, const IArray<int>& counts, const IArray<float3>& vertices)
 {
-    size_t num_points = vertices.size();
-    size_t num_faces = counts.size();
-    size_t num_indices = indices.size();
+    // counting sort of indices by point.
+    // faces are split into chunks and each chunk has its own histogram. chunks scatter their indices
+    // at (point offset + sum of counts of preceding chunks), so the order within each point is
+    // ascending index order regardless of how chunks are scheduled.
+    const int min_indices_per_chunk = 64 * 1024;
+    const int points_per_block = 16 * 1024;
+
+    int num_points = (int)vertices.size();
+    int num_faces = (int)counts.size();
+    int num_indices = (int)indices.size();
 
+    v2f_counts.resize_discard(num_points);
     v2f_offsets.resize_discard(num_points);
     v2f_faces.resize_discard(num_indices);
     v2f_indices.resize_discard(num_indices);
 
-    v2f_counts.resize_zeroclear(num_points);
-    {
-        int ii = 0;
-        for (size_t fi = 0; fi < num_faces; ++fi)
+    int num_chunks = std::min(aiTaskPool::getInstance().getConcurrency(), num_indices / min_indices_per_chunk);
+    num_chunks = std::max(std::min(num_chunks, num_faces), 1);
+    int faces_per_chunk = (num_faces + num_chunks - 1) / num_chunks;
+
+    // scratch. the histograms take num_chunks * num_points ints, so they are not kept with the connection.
+    RawVector<int> chunk_offsets, chunk_counts, block_offsets;
+
+    // index offset of each chunk
+    chunk_offsets.resize_discard(num_chunks + 1);
+    aiParallelFor(0, num_chunks, 1, [&](int begin, int end) {
+        for (int c = begin; c < end; ++c)
         {
-            int c = counts[fi];
-            for (int ci = 0; ci < c; ++ci)
-            {
-                v2f_counts[indices[ii + ci]]++;
-            }
-            ii += c;
+            int fend = std::min((c + 1) * faces_per_chunk, num_faces);
+            int n = 0;
+            for (int fi = c * faces_per_chunk; fi < fend; ++fi)
+                n += counts[fi];
+            chunk_offsets[c + 1] = n;
+        }
+    });
+    chunk_offsets[0] = 0;
+    for (int c = 0; c < num_chunks; ++c)
+        chunk_offsets[c + 1] += chunk_offsets[c];
+
+    // per-chunk histograms
+    chunk_counts.resize_discard((size_t)num_chunks * num_points);
+    aiParallelFor(0, num_chunks, 1, [&](int begin, int end) {
+        for (int c = begin; c < end; ++c)
+        {
+            int *hist = chunk_counts.data() + (size_t)c * num_points;
+            memset(hist, 0, sizeof(int) * num_points);
+            int iend = chunk_offsets[c + 1];
+            for (int ii = chunk_offsets[c]; ii < iend; ++ii)
+                hist[indices[ii]]++;
         }
+    });
 
-        int offset = 0;
-        for (size_t i = 0; i < num_points; ++i)
+    // turn histograms into per-chunk offsets within each point, and take prefix sum of counts in each block of points
+    int num_blocks = (num_points + points_per_block - 1) / points_per_block;
+    block_offsets.resize_discard(num_blocks + 1);
+    aiParallelFor(0, num_blocks, 1, [&](int begin, int end) {
+        for (int b = begin; b < end; ++b)
         {
-            v2f_offsets[i] = offset;
-            offset += v2f_counts[i];
+            int vend = std::min((b + 1) * points_per_block, num_points);
+            int offset = 0;
+            for (int vi = b * points_per_block; vi < vend; ++vi)
+            {
+                int n = 0;
+                for (int c = 0; c < num_chunks; ++c)
+                {
+                    int& h = chunk_counts[(size_t)c * num_points + vi];
+                    int t = h;
+                    h = n;
+                    n += t;
+                }
+                v2f_counts[vi] = n;
+                v2f_offsets[vi] = offset;
+                offset += n;
+            }
+            block_offsets[b + 1] = offset;
         }
+    });
+    block_offsets[0] = 0;
+    for (int b = 0; b < num_blocks; ++b)
+        block_offsets[b + 1] += block_offsets[b];
+    if (num_blocks > 1)
+    {
+        aiParallelFor(1, num_blocks, 1, [&](int begin, int end) {
+            for (int b = begin; b < end; ++b)
+            {
+                int base = block_offsets[b];
+                int vend = std::min((b + 1) * points_per_block, num_points);
+                for (int vi = b * points_per_block; vi < vend; ++vi)
+                    v2f_offsets[vi] += base;
+            }
+        });
     }
 
-    v2f_counts.zeroclear();
-    {
-        int i = 0;
-        for (int fi = 0; fi < (int)num_faces; ++fi)
+    // scatter
+    aiParallelFor(0, num_chunks, 1, [&](int begin, int end) {
+        for (int c = begin; c < end; ++c)
         {
-            int c = counts[fi];
-            for (int ci = 0; ci < c; ++ci)
+            int *pos = chunk_counts.data() + (size_t)c * num_points;
+            int fend = std::min((c + 1) * faces_per_chunk, num_faces);
+            int ii = chunk_offsets[c];
+            for (int fi = c * faces_per_chunk; fi < fend; ++fi)
             {
-                int vi = indices[i + ci];
-                int ti = v2f_offsets[vi] + v2f_counts[vi]++;
-                v2f_faces[ti] = fi;
-                v2f_indices[ti] = i + ci;
+                int n = counts[fi];
+                for (int ci = 0; ci < n; ++ci, ++ii)
+                {
+                    int vi = indices[ii];
+                    int ti = v2f_offsets[vi] + pos[vi]++;
+                    v2f_faces[ti] = fi;
+                    v2f_indices[ti] = ii;
+                }
             }
-            i += c;
         }
-    }
+    });
 }
 
 static inline int next_power_of_two(uint32_t v)
@@ -439,24 +453,222 @@ void MeshRefiner::clear()
     connection.clear();
 }
 
-void MeshRefiner::refine()
+void MeshFaceTable::build(const IArray<int>& counts)
 {
-    if (connection.v2f_counts.size() != points.size())
+    int num_faces = (int)counts.size();
+    face_offsets.resize_discard(num_faces + 1);
+    tri_offsets.resize_discard(num_faces + 1);
+
+    int num_indices = 0, num_triangles = 0;
+    for (int fi = 0; fi < num_faces; ++fi)
     {
-        connection.buildConnection(indices, counts, points);
+        face_offsets[fi] = num_indices;
+        tri_offsets[fi] = num_triangles;
+        int count = counts[fi];
+        num_indices += count;
+        num_triangles += std::max(count - 2, 0);
     }
+    face_offsets[num_faces] = num_indices;
+    tri_offsets[num_faces] = num_triangles;
 
-    int num_indices = (int)indices.size();
-    new_points.reserve(num_indices);
-    new_indices.reserve(num_indices);
+    triangles.resize_discard(num_triangles * 3);
+    int *dst = triangles.data();
+    for (int fi = 0; fi < num_faces; ++fi)
+    {
+        int first = face_offsets[fi];
+        int nt = tri_offsets[fi + 1] - tri_offsets[fi];
+        for (int ti = 0; ti < nt; ++ti)
+        {
+            *dst++ = first;
+            *dst++ = first + ti + 1;
+            *dst++ = first + ti + 2;
+        }
+    }
+}
+
+void MeshFaceTable::clear()
+{
+    face_offsets.clear();
+    tri_offsets.clear();
+    triangles.clear();
+}
+
+void PointNormalsGenerator::clear()
+{
+    m_face_normals.clear();
+    m_corner_normals.clear();
+    m_point_normals.clear();
+}
+
+bool PointNormalsGenerator::splitsHardEdges(float smoothing_angle)
+{
+    return smoothing_angle < 180.0f;
+}
+
+const RawVector<abcV3>& PointNormalsGenerator::generateImpl(
+    const MeshFaceTable& faces, const IArray<int>& indices, const abcV3 *points,
+    const MeshConnectionInfo& connection, bool angle_weighted, float smoothing_angle)
+{
+    const int grain = 4096;
+    int num_faces = std::max((int)faces.face_offsets.size() - 1, 0);
+    int num_points = (int)connection.v2f_counts.size();
+    bool hard_edges = splitsHardEdges(smoothing_angle);
+
+    if (angle_weighted || hard_edges)
+    {
+        m_face_normals.resize_discard(num_faces);
+        aiParallelFor(0, num_faces, grain, [&](int begin, int end) {
+            GenerateFaceNormals(m_face_normals.data() + begin,
+                faces.tri_offsets.data() + begin, faces.triangles.data(),
+                indices.data(), points, end - begin);
+        });
+    }
+
+    m_corner_normals.resize_discard(indices.size());
+    aiParallelFor(0, num_faces, grain, [&](int begin, int end) {
+        if (angle_weighted)
+        {
+            GenerateCornerNormalsAngleWeighted(m_corner_normals.data(),
+                faces.face_offsets.data() + begin, m_face_normals.data() + begin,
+                indices.data(), points, end - begin);
+        }
+        else
+        {
+            GenerateCornerNormals(m_corner_normals.data(),
+                faces.face_offsets.data() + begin, faces.tri_offsets.data() + begin, faces.triangles.data(),
+                indices.data(), points, end - begin);
+        }
+    });
+
+    if (hard_edges)
+    {
+        // per corner. reuses m_point_normals as the destination
+        float cos_threshold = std::cos(std::max(smoothing_angle, 0.0f) * aiPI / 180.0f);
+        m_point_normals.resize_discard(indices.size());
+        aiParallelFor(0, num_faces, grain, [&](int begin, int end) {
+            GatherSmoothedCornerNormals(m_point_normals.data(), m_corner_normals.data(),
+                m_face_normals.data(), faces.face_offsets.data(), indices.data(),
+                connection.v2f_counts.data(), connection.v2f_offsets.data(),
+                connection.v2f_faces.data(), connection.v2f_indices.data(),
+                cos_threshold, begin, end);
+        });
+    }
+    else
+    {
+        m_point_normals.resize_discard(num_points);
+        aiParallelFor(0, num_points, grain, [&](int begin, int end) {
+            GatherPointNormals(m_point_normals.data() + begin, m_corner_normals.data(),
+                connection.v2f_counts.data() + begin, connection.v2f_offsets.data() + begin, connection.v2f_indices.data(),
+                end - begin);
+        });
+    }
+    return m_point_normals;
+}
+
+void PointNormalsGenerator::generate(abcV3 *dst, const IArray<int>& remap,
+    const MeshFaceTable& faces, const IArray<int>& indices, const abcV3 *points,
+    const MeshConnectionInfo& connection, bool angle_weighted, float smoothing_angle)
+{
+    const int grain = 4096;
+
+    auto& normals = generateImpl(faces, indices, points, connection, angle_weighted, smoothing_angle);
+
+    const abcV3 swap_handedness(-1.0f, 1.0f, 1.0f);
+    aiParallelFor(0, (int)remap.size(), grain, [&](int begin, int end) {
+        RemapTransform(dst + begin, normals.data(), remap.data() + begin, end - begin, swap_handedness);
+    });
+}
+
+void PointNormalsGenerator::generateCorners(RawVector<abcV3>& dst,
+    const MeshFaceTable& faces, const IArray<int>& indices, const abcV3 *points,
+    const MeshConnectionInfo& connection, bool angle_weighted, float smoothing_angle)
+{
+    dst = generateImpl(faces, indices, points, connection, angle_weighted, smoothing_angle);
+}
+
+void MikkTangentsGenerator::buildConnection(MeshConnectionInfo& dst, const IArray<int>& triangles, int num_vertices)
+{
+    RawVector<int> counts;
+    counts.resize_discard(triangles.size() / 3);
+    std::fill(counts.begin(), counts.end(), 3);
+    // MeshConnectionInfo::buildConnection() only needs the number of vertices
+    dst.buildConnection(triangles, counts, { (const float3*)nullptr, (size_t)num_vertices });
+}
+
+void MikkTangentsGenerator::generate(abcV4 *dst, const abcV3 *points, const abcV2 *uv, const abcV3 *normals,
+    const IArray<int>& triangles, const MeshConnectionInfo& connection)
+{
+    const int grain = 4096;
+
+    int num_triangles = (int)triangles.size() / 3;
+    int num_vertices = (int)connection.v2f_counts.size();
+
+    m_corner_tangents.resize_discard(triangles.size());
+    aiParallelFor(0, num_triangles, grain, [&](int begin, int end) {
+        GenerateCornerTangents(m_corner_tangents.data() + begin * 3, points, uv, normals,
+            triangles.data() + begin * 3, end - begin);
+    });
+
+    aiParallelFor(0, num_vertices, grain, [&](int begin, int end) {
+        GatherVertexTangents(dst + begin, m_corner_tangents.data(),
+            connection.v2f_counts.data() + begin, connection.v2f_offsets.data() + begin, connection.v2f_indices.data(),
+            end - begin);
+    });
+}
+
+void MikkTangentsGenerator::clear()
+{
+    m_corner_tangents.clear();
+}
+
+bool MeshRefiner::isGenerated(int count) const
+{
+    return (count >= 3 && gen_triangles) || (count == 2 && gen_lines) || (count == 1 && gen_points);
+}
+
+void MeshRefiner::refine()
+{
     for (auto& attr : attributes)
     {
         attr->prepare((int)points.size(), (int)indices.size());
     }
+    PolymorphicAttributes attrs{ attributes };
+    refineImpl(attrs);
+}
 
-    old2new_indices.resize(num_indices, -1);
+void MeshRefiner::beginRefine()
+{
+    if (connection.v2f_counts.size() != points.size())
+    {
+        connection.buildConnection(indices, counts, points);
+    }
 
     int num_faces_total = (int)counts.size();
+    face_offsets.resize_discard(num_faces_total);
+    face_new_offsets.resize_discard(num_faces_total);
+    int offset = 0;
+    int num_new_indices = 0;
+    for (int fi = 0; fi < num_faces_total; ++fi)
+    {
+        int count = counts[fi];
+        face_offsets[fi] = offset;
+        face_new_offsets[fi] = num_new_indices;
+        offset += count;
+        if (isGenerated(count))
+            num_new_indices += count;
+    }
+    new_indices.resize_discard(num_new_indices);
+}
+
+int MeshRefiner::splitIndices()
+{
+    const int grain = refine_grain;
+    int num_faces_total = (int)counts.size();
+    int num_new_indices = (int)new_indices.size();
+
+    // splits. the split boundaries depend on the number of vertices emitted so far, so this pass is serial.
+    // it is skipped if there are not enough indices to reach split_unit.
+    bool need_split = split_unit > 0 && num_new_indices > split_unit;
     int offset_faces = 0;
     int offset_indices = 0;
     int offset_vertices = 0;
@@ -464,6 +676,8 @@ void MeshRefiner::refine()
     int num_indices_tri = 0;
     int num_indices_lines = 0;
     int num_indices_points = 0;
+    int num_new_points = 0;
+    int num_new_indices_done = 0;
 
     auto add_new_split = [&]() {
             auto split = Split{};
@@ -474,8 +688,8 @@ void MeshRefiner::refine()
             split.index_count_tri = num_indices_tri;
             split.index_count_lines = num_indices_lines;
             split.index_count_points = num_indices_points;
-            split.vertex_count = (int)new_points.size() - offset_vertices;
-            split.index_count = (int)new_indices.size() - offset_indices;
+            split.vertex_count = num_new_points - offset_vertices;
+            split.index_count = num_new_indices_done - offset_indices;
             splits.push_back(split);
 
             offset_faces += split.face_count;
@@ -488,66 +702,92 @@ void MeshRefiner::refine()
             num_indices_points = 0;
         };
 
-    auto compare_all_attributes = [&](int ni, int ii) -> bool {
-            for (auto& attr : attributes)
-                if (!attr->compare(ni, ii)) { return false; }
-            return true;
-        };
-
-    auto find_or_emit_vertex = [&](int vi, int ii) -> int {
-            int offset = connection.v2f_offsets[vi];
-            int connection_count = connection.v2f_counts[vi];
-            for (int ci = 0; ci < connection_count; ++ci)
-            {
-                int& ni = old2new_indices[connection.v2f_indices[offset + ci]];
-                if (ni != -1 && compare_all_attributes(ni, ii))
-                {
-                    return ni;
-                }
-                else
-                {
-                    ni = (int)new_points.size();
-                    new_points.push_back(points[vi]);
-                    new2old_points.push_back(vi);
-                    for (auto& attr : attributes)
-                    {
-                        attr->emit(ii);
-                    }
-                    return ni;
-                }
-            }
-            return 0;
-        };
-
-    int offset = 0;
+    int split_begin = 0; // first index of the current split
     for (int fi = 0; fi < num_faces_total; ++fi)
     {
         int count = counts[fi];
-        if ((count >= 3 && gen_triangles) || (count == 2 && gen_lines) || (count == 1 && gen_points))
+        if (!isGenerated(count))
+            continue;
+
+        if (need_split)
         {
-            if (split_unit > 0 && (int)new_points.size() - offset_vertices + count > split_unit)
+            if (num_new_points - offset_vertices + count > split_unit)
             {
                 add_new_split();
-
-                // clear vertex cache
-                memset(old2new_indices.data(), -1, old2new_indices.size() * sizeof(int));
+                split_begin = face_offsets[fi];
             }
 
+            // vertices of the previous split can't be shared
+            int offset = face_offsets[fi];
             for (int ci = 0; ci < count; ++ci)
             {
-                int ii = offset + ci;
-                int vi = indices[ii];
-                new_indices.push_back(find_or_emit_vertex(vi, ii));
+                int& prev = prev_refs[offset + ci];
+                if (prev < split_begin)
+                    prev = -1;
+                if (prev == -1)
+                    ++num_new_points;
             }
-            ++num_faces;
-            if (count >= 3)
-                num_indices_tri += (count - 2) * 3;
-            else if (count == 2)
-                num_indices_lines += 2;
-            else if (count == 1)
-                num_indices_points += 1;
         }
-        offset += count;
+
+        num_new_indices_done += count;
+        ++num_faces;
+        if (count >= 3)
+            num_indices_tri += (count - 2) * 3;
+        else if (count == 2)
+            num_indices_lines += 2;
+        else if (count == 1)
+            num_indices_points += 1;
     }
+
+    // number the new vertices: count per chunk of faces, then prefix sum
+    int num_chunks = (num_faces_total + grain - 1) / grain;
+    chunk_offsets.resize_discard(num_chunks + 1);
+    aiParallelFor(0, num_chunks, 1, [this, grain, num_faces_total](int begin, int end) {
+        for (int ci = begin; ci < end; ++ci)
+        {
+            int n = 0;
+            int face_end = std::min((ci + 1) * grain, num_faces_total);
+            for (int fi = ci * grain; fi < face_end; ++fi)
+            {
+                int count = counts[fi];
+                if (!isGenerated(count))
+                    continue;
+                int offset = face_offsets[fi];
+                for (int i = 0; i < count; ++i)
+                {
+                    if (prev_refs[offset + i] == -1)
+                        ++n;
+                }
+            }
+            chunk_offsets[ci + 1] = n;
+        }
+    });
+    chunk_offsets[0] = 0;
+    for (int ci = 0; ci < num_chunks; ++ci)
+        chunk_offsets[ci + 1] += chunk_offsets[ci];
+    num_new_points = chunk_offsets[num_chunks];
     add_new_split();
+
+    old2new_indices.resize_discard(indices.size());
+    new_points.resize_discard(num_new_points);
+    new2old_points.resize_discard(num_new_points);
+    return num_new_points;
+}
+
+void MeshRefiner::resolveIndices()
+{
+    // resolve shared vertices and build new indices. links never cross points, so points can go in parallel.
+    aiParallelFor(0, (int)points.size(), refine_grain, [this](int begin, int end) {
+        for (int vi = begin; vi < end; ++vi)
+        {
+            connection.eachConnectedFaces(vi, [&](int fi, int ii) {
+                if (!isGenerated(counts[fi]))
+                    return;
+                int prev = prev_refs[ii];
+                if (prev != -1)
+                    old2new_indices[ii] = old2new_indices[prev];
+                new_indices[face_new_offsets[fi] + (ii - face_offsets[fi])] = old2new_indices[ii];
+            });
+        }
+    });
 }
@@ -2,6 +2,7 @@
 #include "RawVector.h"
 #include "aiIntrusiveArray.h"
 #include "aiMath.h"
+#include "aiTaskPool.h"
 
 
 struct MeshConnectionInfo
@@ -46,6 +47,71 @@ struct MeshConnectionInfo
 };
 
 
+// per face tables that depend only on counts. built once per topology, so per frame normal generation only reads points.
+struct MeshFaceTable
+{
+    RawVector<int> face_offsets; // num_faces + 1 entries. face fi owns index positions [face_offsets[fi], face_offsets[fi + 1])
+    RawVector<int> tri_offsets;  // num_faces + 1 entries. face fi owns fan triangles [tri_offsets[fi], tri_offsets[fi + 1])
+    RawVector<int> triangles;    // 3 index positions per triangle: (first, first + i + 1, first + i + 2)
+
+    void build(const IArray<int>& counts);
+    void clear();
+};
+
+// smooth normals of polygon meshes. faces are fan triangulated (see MeshFaceTable).
+// corner normals are computed per face chunk, area weighted (fan triangle normals) or angle weighted (unit face normal
+// times the polygon angle at the corner). then each point gathers the corners it is connected to through
+// MeshConnectionInfo, so no two tasks write the same element.
+// with a smoothing angle below 180 degrees, each corner gathers only the corners of faces within that angle of its own
+// face. the result is per corner then, and the refiner must have split vertices accordingly (see generateCorners()).
+// the scratch buffers are kept across calls. a generator must not be used by two updates at once: each schema has its
+// own, while the face table and the connection it reads may be shared with other contexts.
+class PointNormalsGenerator
+{
+public:
+    // dst[i] = normal of points[remap[i]] with x negated (left handed).
+    // with hard edges remap must be to index positions (corners) instead of points.
+    void generate(abcV3 *dst, const IArray<int>& remap,
+        const MeshFaceTable& faces, const IArray<int>& indices, const abcV3 *points,
+        const MeshConnectionInfo& connection, bool angle_weighted = false, float smoothing_angle = 180.0f);
+    // dst[ii] = normal of index position ii. no handedness conversion.
+    // feed this to the refiner as an expanded attribute to split vertices on hard edges.
+    void generateCorners(RawVector<abcV3>& dst,
+        const MeshFaceTable& faces, const IArray<int>& indices, const abcV3 *points,
+        const MeshConnectionInfo& connection, bool angle_weighted, float smoothing_angle);
+    void clear();
+
+    static bool splitsHardEdges(float smoothing_angle);
+
+private:
+    const RawVector<abcV3>& generateImpl(
+        const MeshFaceTable& faces, const IArray<int>& indices, const abcV3 *points,
+        const MeshConnectionInfo& connection, bool angle_weighted, float smoothing_angle);
+
+    RawVector<abcV3> m_face_normals;
+    RawVector<abcV3> m_corner_normals;
+    RawVector<abcV3> m_point_normals;
+};
+
+
+// MikkTSpace compatible vertex tangents of triangulated meshes. tangents follow +u projected onto the normal plane
+// and are weighted by the angle of each triangle at the vertex. w is -1 where the uv mapping is mirrored.
+// vertices are not split further, so a vertex shared by mirrored and non-mirrored triangles gets one blended tangent.
+// corner tangents are computed per triangle chunk, then each vertex gathers its corners through a vertex to corner
+// table that buildConnection() makes once per topology. the table can be shared, the generator keeps per caller scratch.
+class MikkTangentsGenerator
+{
+public:
+    static void buildConnection(MeshConnectionInfo& dst, const IArray<int>& triangles, int num_vertices);
+    void generate(abcV4 *dst, const abcV3 *points, const abcV2 *uv, const abcV3 *normals,
+        const IArray<int>& triangles, const MeshConnectionInfo& connection);
+    void clear();
+
+private:
+    RawVector<abcV4> m_corner_tangents;
+};
+
+
 class MeshWelder
 {
 public:
@@ -117,7 +183,7 @@ struct MeshRefiner
     IArray<float3> points;
 
     // outputs
-    RawVector<int> old2new_indices; // old index to new index
+    RawVector<int> old2new_indices; // old index to new index. -1 for indices of faces that are not generated
     RawVector<int> new2old_points;  // new index to old vertex
     RawVector<int> new_indices;     // non-triangulated new indices
     RawVector<int> new_indices_tri;
@@ -149,7 +215,72 @@ struct MeshRefiner
         attr->new2old = &new2old;
     }
 
+    // attribute whose type is known at compile time. passed to refine(Attrs&...).
+    // indices is empty if values are expanded (one value per index).
+    template<class T>
+    struct Attribute
+    {
+        IArray<T> values;
+        IArray<int> indices;
+        RawVector<T> *new_values = nullptr;
+        RawVector<int> *new2old = nullptr;
+
+        void setIndexed(const IArray<T>& values_, const IArray<int>& indices_, RawVector<T>& new_values_, RawVector<int>& new2old_)
+        {
+            values = values_;
+            indices = indices_;
+            new_values = &new_values_;
+            new2old = &new2old_;
+        }
+
+        void setExpanded(const IArray<T>& values_, RawVector<T>& new_values_, RawVector<int>& new2old_)
+        {
+            values = values_;
+            indices.reset();
+            new_values = &new_values_;
+            new2old = &new2old_;
+        }
+
+        bool valid() const { return new_values != nullptr; }
+        int valueIndex(int ii) const { return indices.empty() ? ii : indices[ii]; }
+
+        bool equals(int ii1, int ii2) const
+        {
+            return !valid() || values[valueIndex(ii1)] == values[valueIndex(ii2)];
+        }
+
+        void resize(int n)
+        {
+            if (valid())
+            {
+                new_values->resize_discard(n);
+                new2old->resize_discard(n);
+            }
+        }
+
+        void emit(int ni, int ii) const
+        {
+            if (valid())
+            {
+                int i = valueIndex(ii);
+                (*new_values)[ni] = values[i];
+                (*new2old)[ni] = i;
+            }
+        }
+    };
+
+    // refines with attributes added by addIndexedAttribute() / addExpandedAttribute()
     void refine();
+
+    // refines with the given Attribute<T>s. attributes that are not set are ignored.
+    // compare and emit of all attributes are inlined into the refine loops, so this is faster than the above.
+    template<class... Attrs>
+    void refine(Attrs&... attrs)
+    {
+        AttributeList<Attrs...> list(attrs...);
+        refineImpl(list);
+    }
+
     void retopology(bool swap_faces);
     void genSubmeshes(IArray<int> material_ids);
     void genSubmeshes();
@@ -161,14 +292,26 @@ struct MeshRefiner
 
 private:
     void setupSubmeshes();
+    bool isGenerated(int count) const;
+
+    template<class Attributes> void refineImpl(Attributes& attrs);
+    template<class Attributes> void linkIndices(const Attributes& attrs);
+    template<class Attributes> void emitVertices(const Attributes& attrs);
+    void beginRefine();
+    int splitIndices();
+    void resolveIndices();
+
+    template<class... Attrs>
+    struct AttributeList;
 
     class IAttribute
     {
     public:
         virtual ~IAttribute() {}
         virtual void prepare(int vertex_count, int index_count) = 0;
-        virtual bool compare(int vertex_index, int index_index) = 0;
-        virtual void emit(int index_index) = 0;
+        virtual bool equals(int index_index1, int index_index2) = 0;
+        virtual void resize(int new_vertex_count) = 0;
+        virtual void emit(int new_vertex_index, int index_index) = 0;
         virtual void clear() = 0;
     };
 
@@ -181,16 +324,22 @@ private:
             clear();
         }
 
-        bool compare(int ni, int ii) override
+        bool equals(int ii1, int ii2) override
         {
-            return (*new_values)[ni] == values[indices[ii]];
+            return values[indices[ii1]] == values[indices[ii2]];
         }
 
-        void emit(int ii) override
+        void resize(int n) override
+        {
+            new_values->resize_discard(n);
+            new2old->resize_discard(n);
+        }
+
+        void emit(int ni, int ii) override
         {
             int i = indices[ii];
-            new_values->push_back(values[i]);
-            new2old->push_back(i);
+            (*new_values)[ni] = values[i];
+            (*new2old)[ni] = i;
         }
 
         void clear() override
@@ -214,20 +363,27 @@ private:
             clear();
         }
 
-        bool compare(int ni, int ii) override
+        bool equals(int ii1, int ii2) override
+        {
+            return values[ii1] == values[ii2];
+        }
+
+        void resize(int n) override
         {
-            return (*new_values)[ni] == values[ii];
+            new_values->resize_discard(n);
+            new2old->resize_discard(n);
         }
 
-        void emit(int ii) override
+        void emit(int ni, int ii) override
         {
-            new_values->push_back(values[ii]);
-            new2old->push_back(ii);
+            (*new_values)[ni] = values[ii];
+            (*new2old)[ni] = ii;
         }
 
         void clear() override
         {
             new_values->clear();
+            new2old->clear();
         }
 
         IArray<T> values;
@@ -250,11 +406,139 @@ private:
         return ret;
     }
 
+    // adapts added attributes to the interface of Attribute<T>
+    struct PolymorphicAttributes
+    {
+        RawVector<IAttribute*>& attributes;
+
+        bool equals(int ii1, int ii2) const
+        {
+            for (auto& attr : attributes)
+            {
+                if (!attr->equals(ii1, ii2))
+                    return false;
+            }
+            return true;
+        }
+
+        void resize(int n)
+        {
+            for (auto& attr : attributes)
+                attr->resize(n);
+        }
+
+        void emit(int ni, int ii) const
+        {
+            for (auto& attr : attributes)
+                attr->emit(ni, ii);
+        }
+    };
+
     RawVector<IAttribute*> attributes;
     RawVector<char> buf_attributes;
+
+    // working buffers of refine()
+    RawVector<int> face_offsets;     // face index to its first index
+    RawVector<int> face_new_offsets; // face index to its first index in new_indices
+    RawVector<int> prev_refs;        // index to the previous index of the same vertex that it can share the new vertex with. -1: emits a new vertex
+    RawVector<int> chunk_offsets;
     static const int max_attributes = 8; // you can increase this if needed
+    static const int refine_grain = 4096;
 };
 
+template<>
+struct MeshRefiner::AttributeList<>
+{
+    bool equals(int, int) const { return true; }
+    void resize(int) {}
+    void emit(int, int) const {}
+};
+
+template<class Attr, class... Rest>
+struct MeshRefiner::AttributeList<Attr, Rest...>
+{
+    Attr& head;
+    AttributeList<Rest...> tail;
+
+    AttributeList(Attr& h, Rest&... r) : head(h), tail(r...) {}
+
+    bool equals(int ii1, int ii2) const { return head.equals(ii1, ii2) && tail.equals(ii1, ii2); }
+    void resize(int n) { head.resize(n); tail.resize(n); }
+    void emit(int ni, int ii) const { head.emit(ni, ii); tail.emit(ni, ii); }
+};
+
+// an index shares the new vertex of the previous index of the same point if all attributes are equal and both are in
+// the same split. otherwise it emits a new vertex. new vertices are numbered in the order of the indices.
+// this gives the same result as finding or emitting vertices one by one, but only the split pass has to be serial.
+template<class Attributes>
+inline void MeshRefiner::refineImpl(Attributes& attrs)
+{
+    beginRefine();
+    linkIndices(attrs);
+    int num_new_points = splitIndices();
+    attrs.resize(num_new_points);
+    emitVertices(attrs);
+    resolveIndices();
+}
+
+// link each index to the previous index of the same point if they can share a vertex
+template<class Attributes>
+inline void MeshRefiner::linkIndices(const Attributes& attrs)
+{
+    prev_refs.resize_discard(indices.size());
+    aiParallelFor(0, (int)points.size(), refine_grain, [this, &attrs](int begin, int end) {
+        for (int vi = begin; vi < end; ++vi)
+        {
+            int prev = -1;
+            connection.eachConnectedFaces(vi, [&](int fi, int ii) {
+                if (!isGenerated(counts[fi]))
+                    return;
+                prev_refs[ii] = prev != -1 && attrs.equals(prev, ii) ? prev : -1;
+                prev = ii;
+            });
+        }
+    });
+}
+
+// emit new vertices. chunk_offsets holds the first new vertex of each chunk of faces.
+template<class Attributes>
+inline void MeshRefiner::emitVertices(const Attributes& attrs)
+{
+    const int grain = refine_grain;
+    int num_faces_total = (int)counts.size();
+    int num_chunks = (int)chunk_offsets.size() - 1;
+    aiParallelFor(0, num_chunks, 1, [this, &attrs, grain, num_faces_total](int begin, int end) {
+        for (int ci = begin; ci < end; ++ci)
+        {
+            int ni = chunk_offsets[ci];
+            int face_end = std::min((ci + 1) * grain, num_faces_total);
+            for (int fi = ci * grain; fi < face_end; ++fi)
+            {
+                int count = counts[fi];
+                int offset = face_offsets[fi];
+                bool generated = isGenerated(count);
+                for (int i = 0; i < count; ++i)
+                {
+                    int ii = offset + i;
+                    if (!generated)
+                    {
+                        old2new_indices[ii] = -1;
+                    }
+                    else if (prev_refs[ii] == -1)
+                    {
+                        int vi = indices[ii];
+                        old2new_indices[ii] = ni;
+                        new_points[ni] = points[vi];
+                        new2old_points[ni] = vi;
+                        attrs.emit(ni, ii);
+                        ++ni;
+                    }
+                }
+            }
+        }
+    });
+}
+
 
 inline uint32_t MeshWelder::hash(const abcV3& value)
 {
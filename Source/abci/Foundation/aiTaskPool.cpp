@@ -0,0 +1,168 @@
+#include "pch.h"
+#include "aiTaskPool.h"
+
+// index of the queue owned by the current thread. -1 for non-worker threads.
+static thread_local int g_worker_index = -1;
+
+aiTaskPool& aiTaskPool::getInstance()
+{
+    // intentionally never destroyed: joining workers from static destructors can dead-lock when the plugin is unloaded
+    static aiTaskPool *s_instance = new aiTaskPool(std::max<int>((int)std::thread::hardware_concurrency() - 1, 1));
+    return *s_instance;
+}
+
+aiTaskPool::aiTaskPool(int num_workers)
+    : m_num_queued(0)
+    , m_next_queue(0)
+{
+    for (int i = 0; i < num_workers; ++i)
+        m_queues.emplace_back(new Queue());
+    for (int i = 0; i < num_workers; ++i)
+        m_workers.emplace_back([this, i]() { workerMain(i); });
+}
+
+int aiTaskPool::getConcurrency() const
+{
+    return (int)m_workers.size() + 1;
+}
+
+void aiTaskPool::push(const Task& task, const aiTaskGroup *group)
+{
+    // workers push to their own queue so that the spawned tasks stay hot in cache.
+    // other threads distribute tasks round-robin.
+    int qi = g_worker_index >= 0 ? g_worker_index : (int)(m_next_queue++ % m_queues.size());
+    {
+        auto& q = *m_queues[qi];
+        std::unique_lock<std::mutex> lock(q.mutex);
+        q.tasks.push_back({ task, group });
+    }
+    ++m_num_queued;
+
+    // lock & unlock to avoid a lost wakeup between the predicate check and the wait in workerMain()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+    }
+    m_cond.notify_one();
+}
+
+bool aiTaskPool::pop(int qi, const aiTaskGroup *group, Task& dst)
+{
+    auto& q = *m_queues[qi];
+    std::unique_lock<std::mutex> lock(q.mutex);
+    for (auto it = q.tasks.rbegin(); it != q.tasks.rend(); ++it)
+    {
+        if (!group || it->group == group)
+        {
+            dst = std::move(it->task);
+            q.tasks.erase(std::next(it).base());
+            --m_num_queued;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool aiTaskPool::steal(int qi, const aiTaskGroup *group, Task& dst)
+{
+    int n = (int)m_queues.size();
+    for (int i = 1; i <= n; ++i)
+    {
+        auto& q = *m_queues[(qi + i) % n];
+        std::unique_lock<std::mutex> lock(q.mutex);
+        for (auto it = q.tasks.begin(); it != q.tasks.end(); ++it)
+        {
+            if (!group || it->group == group)
+            {
+                dst = std::move(it->task);
+                q.tasks.erase(it);
+                --m_num_queued;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool aiTaskPool::tryRunOne(const aiTaskGroup *group)
+{
+    if (m_num_queued == 0)
+        return false;
+
+    Task task;
+    int qi = g_worker_index;
+    if ((qi >= 0 && pop(qi, group, task)) || steal(qi >= 0 ? qi : 0, group, task))
+    {
+        task();
+        return true;
+    }
+    return false;
+}
+
+void aiTaskPool::workerMain(int wi)
+{
+    g_worker_index = wi;
+    for (;;)
+    {
+        Task task;
+        if (pop(wi, nullptr, task) || steal(wi, nullptr, task))
+        {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this]() { return m_num_queued > 0; });
+    }
+}
+
+
+aiTaskGroup::aiTaskGroup()
+    : m_pending(0)
+{
+}
+
+aiTaskGroup::~aiTaskGroup()
+{
+    // tasks refer to this group. make sure all of them are finished before it goes away.
+    while (m_pending > 0)
+    {
+        if (!aiTaskPool::getInstance().tryRunOne(this))
+            std::this_thread::yield();
+    }
+}
+
+void aiTaskGroup::run(const std::function<void()>& f)
+{
+    ++m_pending;
+    aiTaskPool::getInstance().push([this, f]() {
+        try
+        {
+            f();
+        }
+        catch (...)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (!m_exception)
+                m_exception = std::current_exception();
+        }
+        --m_pending;
+    }, this);
+}
+
+void aiTaskGroup::wait()
+{
+    auto& pool = aiTaskPool::getInstance();
+    while (m_pending > 0)
+    {
+        if (!pool.tryRunOne(this))
+            std::this_thread::yield();
+    }
+
+    std::exception_ptr e;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        std::swap(e, m_exception);
+    }
+    if (e)
+        std::rethrow_exception(e);
+}
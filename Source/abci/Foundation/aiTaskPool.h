@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+
+class aiTaskGroup;
+
+// work-stealing task pool shared by all contexts.
+// each worker owns a deque. it pops its own tasks from the back and steals from the front of the others.
+// threads waiting on an aiTaskGroup run pending tasks of that group instead of blocking, so groups can be nested.
+// they never pick up unrelated tasks: that would nest them without bound and could put a prefetch read of another
+// schema on the waiting thread.
+class aiTaskPool
+{
+public:
+    using Task = std::function<void()>;
+
+    static aiTaskPool& getInstance();
+
+    // number of threads that can run tasks at the same time (workers + the waiting thread)
+    int getConcurrency() const;
+
+    void push(const Task& task, const aiTaskGroup *group = nullptr);
+    // runs one queued task of group. null: any task
+    bool tryRunOne(const aiTaskGroup *group);
+
+private:
+    struct Entry
+    {
+        Task task;
+        const aiTaskGroup *group;
+    };
+
+    aiTaskPool(int num_workers);
+    void workerMain(int wi);
+    bool pop(int qi, const aiTaskGroup *group, Task& dst);
+    bool steal(int qi, const aiTaskGroup *group, Task& dst);
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Entry> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue> > m_queues;
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::atomic<int> m_num_queued;
+    std::atomic<uint32_t> m_next_queue;
+};
+
+
+class aiTaskGroup
+{
+public:
+    aiTaskGroup();
+    ~aiTaskGroup();
+
+    void run(const std::function<void()>& f);
+
+    // runs pending tasks on the calling thread until all tasks of this group are done.
+    // rethrows the first exception thrown by a task.
+    void wait();
+
+private:
+    std::atomic<int> m_pending;
+    std::mutex m_mutex;
+    std::exception_ptr m_exception;
+};
+
+
+// Body: [](int begin, int end) -> void
+template<class Body>
+inline void aiParallelFor(int begin, int end, int grain, const Body& body)
+{
+    if (end - begin <= grain || aiTaskPool::getInstance().getConcurrency() <= 1)
+    {
+        body(begin, end);
+        return;
+    }
+
+    aiTaskGroup group;
+    for (int i = begin; i < end; i += grain)
+    {
+        int e = std::min(i + grain, end);
+        group.run([&body, i, e]() { body(i, e); });
+    }
+    group.wait();
+}
@@ -45,6 +45,27 @@ abciAPI bool aiContextLoad(aiContext* ctx, const char *path)
     return ctx ? ctx->load(path) : false;
 }
 
+abciAPI void aiContextLoadAsync(aiContext* ctx, const char *path)
+{
+    if (ctx)
+        ctx->loadAsync(path);
+}
+
+abciAPI aiLoadState aiContextGetLoadState(aiContext* ctx)
+{
+    return ctx ? ctx->getLoadState() : aiLoadState::None;
+}
+
+abciAPI int aiContextGetLoadProgress(aiContext* ctx)
+{
+    return ctx ? ctx->getLoadProgress() : 0;
+}
+
+abciAPI bool aiContextWaitLoad(aiContext* ctx)
+{
+    return ctx ? ctx->waitLoad() : false;
+}
+
 abciAPI bool aiContextGetIsHDF5(aiContext* ctx)
 {
     return ctx ? ctx->getIsHDF5() : false;
@@ -83,6 +104,18 @@ abciAPI void aiContextUpdateSamples(aiContext* ctx, double time)
         ctx->updateSamples(time);
 }
 
+abciAPI void aiContextGetSampleCacheStats(aiContext* ctx, aiSampleCacheStats *dst)
+{
+    if (ctx)
+        ctx->getSampleCacheStats(*dst);
+}
+
+abciAPI void aiContextGetBakeStats(aiContext* ctx, aiBakeStats *dst)
+{
+    if (ctx)
+        *dst = ctx->getBakeStats();
+}
+
 abciAPI int aiTimeSamplingGetSampleCount(aiTimeSampling *self)
 {
     return self ? (int)self->getSampleCount() : 0;
@@ -218,6 +251,18 @@ abciAPI void aiPolyMeshGetSummary(aiPolyMesh* schema, aiMeshSummary* dst)
         *dst = schema->getSummary();
 }
 
+abciAPI void aiPolyMeshGetSkipStats(aiPolyMesh* schema, aiMeshSkipStats* dst)
+{
+    if (schema)
+        schema->getSkipStats(*dst);
+}
+
+abciAPI void aiPolyMeshSetDestinationBuffers(aiPolyMesh* schema, const aiPolyMeshData* vbs, int split_count)
+{
+    if (schema)
+        schema->setDestinationBuffers(vbs, split_count);
+}
+
 abciAPI void aiPolyMeshGetSampleSummary(aiPolyMeshSample* sample, aiMeshSampleSummary* dst)
 {
     if (sample)
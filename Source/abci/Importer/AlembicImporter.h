@@ -39,10 +39,18 @@ enum class NormalsMode
     //Ignore
 };
 
+// how computed normals accumulate the faces around a point
+enum class NormalsWeighting
+{
+    Area,  // by the area of the (fan triangulated) faces
+    Angle, // by the angle of the polygon at the point
+};
+
 enum class TangentsMode
 {
     None,
     Compute,
+    MikkTSpace, // matches MikkTSpace based bakers. see MikkTangentsGenerator
 };
 
 enum class aiTimeSamplingType
@@ -67,6 +75,14 @@ enum class aiTopology
     Quads,
 };
 
+enum class aiLoadState
+{
+    None,
+    Loading,
+    Succeeded,
+    Failed,
+};
+
 enum class aiPropertyType
 {
     Unknown,
@@ -112,6 +128,54 @@ struct aiConfig
     bool import_point_polygon = true;
     bool import_line_polygon = true;
     bool import_triangle_polygon = true;
+    bool parallel_update = false; // update schemas on the task pool in aiContextUpdateSamples()
+    bool prefetch_samples = false; // read the next sample in background after each update
+    bool use_mmap = false; // read archives through a memory mapping instead of std::ifstream (non-Windows)
+    int stream_count = 1; // number of Ogawa streams per archive. <= 0: one per task pool thread
+    bool share_archives = false; // share the archive and constant cooked data among contexts that load the same path
+    bool lazy_load = false; // create child nodes on first access instead of at load time
+    int sample_cache_size = 0; // memory budget in MB for cooked samples of recently visited frames. 0: disabled
+    bool prebake_samples = false; // read and cook all samples at load time. updates become lookups + interpolation
+    bool compress_cached_samples = false; // keep the points of cached / baked deforming meshes as 16 bit quantized deltas (lossy)
+    bool detect_constant_topology = false; // treat heterogeneous meshes whose counts & indices never change as homogeneous. checked at load time
+    bool skip_unchanged_attributes = false; // compare array sample keys with the previous sample to skip fetching and remapping unchanged attributes
+    int topology_cache_size = 0; // number of refined topologies kept per varying-topology mesh to reuse when identical ones reappear. 0: disabled. not used when an attribute is constant
+    NormalsWeighting normals_weighting = NormalsWeighting::Area; // for computed normals
+    float smoothing_angle = 180.0f; // degrees. computed normals are split on edges sharper than this. >= 180: all smooth
+    bool direct_write = false; // interpolate vertex streams straight into the buffers registered by aiPolyMeshSetDestinationBuffers()
+};
+
+struct aiSampleCacheStats
+{
+    int64_t hits = 0;
+    int64_t misses = 0;
+    int64_t memory_usage = 0; // in bytes
+    int sample_count = 0;
+};
+
+struct aiBakeStats
+{
+    double bake_time = 0.0; // in seconds
+    int64_t memory_usage = 0; // in bytes. nothing is released while baking, so this is also the peak
+    int sample_count = 0;
+    int schema_count = 0;
+};
+
+// number of array samples whose fetch or remap was skipped by aiConfig::skip_unchanged_attributes
+struct aiMeshSkipStats
+{
+    int64_t points_read_skips = 0;
+    int64_t points_remap_skips = 0;
+    int64_t normals_read_skips = 0;
+    int64_t normals_remap_skips = 0;
+    int64_t uv0_read_skips = 0;
+    int64_t uv0_remap_skips = 0;
+    int64_t uv1_read_skips = 0;
+    int64_t uv1_remap_skips = 0;
+    int64_t rgba_read_skips = 0;
+    int64_t rgba_remap_skips = 0;
+    int64_t rgb_read_skips = 0;
+    int64_t rgb_remap_skips = 0;
 };
 
 struct aiXformData
@@ -276,6 +340,11 @@ abciAPI void            aiClearContextsWithPath(const char *path);
 abciAPI aiContext*      aiContextCreate(int uid);
 abciAPI void            aiContextDestroy(aiContext* ctx);
 abciAPI bool            aiContextLoad(aiContext* ctx, const char *path);
+// opens the archive on a worker thread. other functions must not be called on ctx until the state is no longer Loading.
+abciAPI void            aiContextLoadAsync(aiContext* ctx, const char *path);
+abciAPI aiLoadState     aiContextGetLoadState(aiContext* ctx);
+abciAPI int             aiContextGetLoadProgress(aiContext* ctx);
+abciAPI bool            aiContextWaitLoad(aiContext* ctx);
 abciAPI bool            aiContextGetIsHDF5(aiContext* ctx);
 abciAPI void            aiContextSetConfig(aiContext* ctx, const aiConfig* conf);
 abciAPI int             aiContextGetTimeSamplingCount(aiContext* ctx);
@@ -283,6 +352,8 @@ abciAPI aiTimeSampling* aiContextGetTimeSampling(aiContext* ctx, int i);
 abciAPI void            aiContextGetTimeRange(aiContext* ctx, double *begin, double *end);
 abciAPI aiObject*       aiContextGetTopObject(aiContext* ctx);
 abciAPI void            aiContextUpdateSamples(aiContext* ctx, double time);
+abciAPI void            aiContextGetSampleCacheStats(aiContext* ctx, aiSampleCacheStats *dst);
+abciAPI void            aiContextGetBakeStats(aiContext* ctx, aiBakeStats *dst);
 
 abciAPI int             aiTimeSamplingGetSampleCount(aiTimeSampling *self);
 abciAPI double          aiTimeSamplingGetTime(aiTimeSampling *self, int index);
@@ -313,6 +384,12 @@ abciAPI aiProperty*     aiSchemaGetPropertyByName(aiSchema* schema, const char *
 abciAPI void            aiXformGetData(aiXformSample* sample, aiXformData *dst);
 
 abciAPI void            aiPolyMeshGetSummary(aiPolyMesh* schema, aiMeshSummary* dst);
+abciAPI void            aiPolyMeshGetSkipStats(aiPolyMesh* schema, aiMeshSkipStats* dst);
+// registers per split vertex buffers (vertex_count must be set) before aiContextUpdateSamples().
+// with aiConfig::direct_write, interpolated streams are written into them directly and aiPolyMeshFillVertexBuffer()
+// doesn't copy them again. the buffers must stay valid until the fill. pass null to unregister.
+// register the same buffers every frame: velocities are computed from the points left in them by the previous frame.
+abciAPI void            aiPolyMeshSetDestinationBuffers(aiPolyMesh* schema, const aiPolyMeshData* vbs, int split_count);
 abciAPI void            aiPolyMeshGetSampleSummary(aiPolyMeshSample* sample, aiMeshSampleSummary* dst);
 abciAPI void            aiPolyMeshGetSplitSummaries(aiPolyMeshSample* sample, aiMeshSplitSummary *dst);
 abciAPI void            aiPolyMeshGetSubmeshSummaries(aiPolyMeshSample* sample, aiSubmeshSummary* dst);
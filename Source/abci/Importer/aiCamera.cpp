@@ -21,6 +21,11 @@ aiCamera::aiCamera(aiObject *parent, const abcObject &abc)
 {
 }
 
+aiCamera::~aiCamera()
+{
+    waitPrefetch();
+}
+
 aiCamera::Sample* aiCamera::newSample()
 {
     return new Sample(this);
@@ -35,6 +40,13 @@ void aiCamera::readSampleBody(Sample& sample, uint64_t idx)
     m_schema.get(sample.cam_sp2, ss2);
 }
 
+bool aiCamera::swapReadData(Sample& dst, Sample& src)
+{
+    std::swap(dst.cam_sp, src.cam_sp);
+    std::swap(dst.cam_sp2, src.cam_sp2);
+    return true;
+}
+
 void aiCamera::cookSampleBody(Sample& sample)
 {
     auto& config = getConfig();
@@ -2,12 +2,19 @@
 #include "aiInternal.h"
 #include "aiContext.h"
 #include "aiObject.h"
+#include "aiSchema.h"
+#include "../Foundation/aiTaskPool.h"
 #include <istream>
 #ifdef WIN32
     #include <windows.h>
     #include <io.h>
     #include <fcntl.h>
     #include <errno.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
 #endif
 
 static std::wstring L(const std::string& s)
@@ -151,8 +158,167 @@ private:
 };
 
 bool lockFreeIStream::updatedIOLimit = false;
+#else
+// read-only memory mapping of a whole file. the streams of an archive share one.
+class mmapFile
+{
+public:
+    mmapFile(const char *path)
+    {
+        int fd = ::open(path, O_RDONLY);
+        if (fd == -1)
+            return;
+
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void *data = ::mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED)
+            {
+                m_data = data;
+                m_size = (size_t)st.st_size;
+                // samples are mostly read forward in time. more read-ahead than the default, without forcing
+                // the whole file into the page cache.
+                ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+            }
+        }
+        // the mapping keeps the file referenced
+        ::close(fd);
+    }
+
+    ~mmapFile()
+    {
+        if (m_data)
+            ::munmap(m_data, m_size);
+    }
+
+    char* data() const { return (char*)m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    void *m_data = nullptr;
+    size_t m_size = 0;
+};
+using mmapFilePtr = std::shared_ptr<mmapFile>;
+
+// read-only istream over a memory mapping of the whole file.
+// reads are served straight from the page cache: no stream buffer and no syscall per read.
+class mmapIStream : public std::istream
+{
+private:
+    class mmapBuffer : public std::streambuf
+    {
+    public:
+        void setData(char *data, size_t size)
+        {
+            setg(data, data, data + size);
+        }
+
+    protected:
+        std::streamsize xsgetn(char *dst, std::streamsize n) override
+        {
+            std::streamsize remain = egptr() - gptr();
+            if (n > remain)
+                n = remain;
+            memcpy(dst, gptr(), (size_t)n);
+            // not gbump(): it takes int and the offset can exceed 2GB
+            setg(eback(), gptr() + n, egptr());
+            return n;
+        }
+
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+        {
+            off_type size = egptr() - eback();
+            off_type base = 0;
+            if (dir == std::ios_base::cur)
+                base = gptr() - eback();
+            else if (dir == std::ios_base::end)
+                base = size;
+
+            off_type pos = base + off;
+            if ((which & std::ios_base::in) == 0 || pos < 0 || pos > size)
+                return pos_type(off_type(-1));
+            setg(eback(), eback() + pos, egptr());
+            return pos_type(pos);
+        }
+
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+        {
+            return seekoff(off_type(pos), std::ios_base::beg, which);
+        }
+    };
+
+public:
+    mmapIStream(const mmapFilePtr& file) : std::istream(nullptr), m_file(file)
+    {
+        if (m_file->data())
+        {
+            m_buffer.setData(m_file->data(), m_file->size());
+            rdbuf(&m_buffer);
+        }
+    }
+
+private:
+    mmapBuffer m_buffer;
+    mmapFilePtr m_file;
+};
 #endif
 
+aiArchive::aiArchive(const std::string& path, std::vector<std::istream*>& streams, Abc::IArchive archive)
+    : m_path(path)
+    , m_archive(archive)
+{
+    m_streams.swap(streams);
+
+    auto num_time_samplings = (int)m_archive.getNumTimeSamplings();
+    for (int i = 0; i < num_time_samplings; ++i)
+    {
+        m_timesamplings.emplace_back(aiCreateTimeSampling(m_archive, i));
+    }
+}
+
+aiArchive::~aiArchive()
+{
+    m_constant_data.clear();
+    m_timesamplings.clear();
+    m_archive.reset();
+    for (auto s : m_streams)
+    {
+        delete s;
+    }
+    m_streams.clear();
+}
+
+const std::string& aiArchive::getPath() const
+{
+    return m_path;
+}
+
+Abc::IArchive aiArchive::getArchive() const
+{
+    return m_archive;
+}
+
+const std::vector<aiTimeSamplingPtr>& aiArchive::getTimeSamplings() const
+{
+    return m_timesamplings;
+}
+
+std::shared_ptr<void> aiArchive::findConstantData(const std::string& key)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_constant_data.find(key);
+    return it != m_constant_data.end() ? it->second : nullptr;
+}
+
+void aiArchive::addConstantData(const std::string& key, const std::shared_ptr<void>& data)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // first one wins. contexts that cooked the same data concurrently keep their own copy.
+    m_constant_data.insert(std::make_pair(key, data));
+}
+
+
 aiContextManager aiContextManager::s_instance;
 
 aiContext* aiContextManager::getContext(int uid)
@@ -197,6 +363,25 @@ void aiContextManager::destroyContextsWithPath(const char* asset_path)
     }
 }
 
+aiArchivePtr aiContextManager::findArchive(const std::string& path)
+{
+    std::unique_lock<std::mutex> lock(s_instance.m_archives_mutex);
+    auto it = s_instance.m_archives.find(path);
+    if (it == s_instance.m_archives.end())
+        return nullptr;
+
+    auto ret = it->second.lock();
+    if (!ret)
+        s_instance.m_archives.erase(it);
+    return ret;
+}
+
+void aiContextManager::addArchive(const aiArchivePtr& archive)
+{
+    std::unique_lock<std::mutex> lock(s_instance.m_archives_mutex);
+    s_instance.m_archives[archive->getPath()] = archive;
+}
+
 aiContextManager::~aiContextManager()
 {
     if (m_contexts.size())
@@ -214,12 +399,19 @@ aiContext::aiContext(int uid)
       m_timesamplings(),
       m_uid(uid),
       m_config(),
+      m_load_state(aiLoadState::None),
+      m_load_progress(0),
+      m_cache_usage(0),
+      m_cache_hits(0),
+      m_cache_misses(0),
+      m_cache_sample_count(0),
       m_isHDF5(false)
 {
 }
 
 aiContext::~aiContext()
 {
+    waitLoad();
     reset();
 }
 
@@ -228,6 +420,11 @@ Abc::IArchive aiContext::getArchive() const
     return m_archive;
 }
 
+aiArchive* aiContext::getSharedArchive() const
+{
+    return m_shared_archive.get();
+}
+
 const std::string& aiContext::getPath() const
 {
     return m_path;
@@ -297,23 +494,106 @@ void aiContext::setConfig(const aiConfig &config)
     m_config = config;
 }
 
-void aiContext::gatherNodesRecursive(aiObject *n)
+void aiContext::addSampleCacheUsage(int64_t bytes, int count)
 {
-    auto& abc = n->getAbcObject();
-    size_t num_children = abc.getNumChildren();
+    m_cache_usage += bytes;
+    m_cache_sample_count += count;
+}
+
+int64_t aiContext::getSampleCacheUsage() const
+{
+    return m_cache_usage;
+}
+
+void aiContext::countSampleCacheAccess(bool hit)
+{
+    if (hit)
+        ++m_cache_hits;
+    else
+        ++m_cache_misses;
+}
+
+void aiContext::getSampleCacheStats(aiSampleCacheStats& dst) const
+{
+    dst.hits = m_cache_hits;
+    dst.misses = m_cache_misses;
+    dst.memory_usage = m_cache_usage;
+    dst.sample_count = m_cache_sample_count;
+}
+
+static void GatherSchemasRecursive(aiObject *n, std::vector<aiSchema*>& dst)
+{
+    uint32_t num_children = n->getNumChildren();
+    for (uint32_t ci = 0; ci < num_children; ++ci)
+    {
+        auto child = n->getChild((int)ci);
+        if (auto schema = dynamic_cast<aiSchema*>(child))
+            dst.push_back(schema);
+        GatherSchemasRecursive(child, dst);
+    }
+}
+
+void aiContext::bakeSamples()
+{
+    m_bake_stats = aiBakeStats();
+    if (!m_top_node)
+        return;
+
+    auto begin = std::chrono::steady_clock::now();
+
+    // this creates all nodes even with lazy_load
+    std::vector<aiSchema*> schemas;
+    GatherSchemasRecursive(m_top_node.get(), schemas);
+
+    std::atomic<int64_t> memory_usage(0);
+    try
+    {
+        aiParallelFor(0, (int)schemas.size(), 1, [&schemas, &memory_usage](int begin, int end) {
+            for (int si = begin; si < end; ++si)
+                memory_usage += (int64_t)schemas[si]->bakeSamples();
+        });
+    }
+    catch (Alembic::Util::Exception e)
+    {
+        // schemas that failed are updated as usual
+        DebugLog("aiContext::bakeSamples: %s", e.what());
+    }
 
-    for (size_t i = 0; i < num_children; ++i)
+    for (auto schema : schemas)
     {
-        auto *child = n->newChild(abc.getChild(i));
-        gatherNodesRecursive(child);
+        int n = schema->getNumBakedSamples();
+        if (n > 0)
+        {
+            m_bake_stats.sample_count += n;
+            ++m_bake_stats.schema_count;
+        }
     }
+    m_bake_stats.memory_usage = memory_usage;
+    m_bake_stats.bake_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    DebugLog("aiContext::bakeSamples: %d samples of %d schemas, %lld bytes, %.3f sec",
+        m_bake_stats.sample_count, m_bake_stats.schema_count, (long long)m_bake_stats.memory_usage, m_bake_stats.bake_time);
+}
+
+const aiBakeStats& aiContext::getBakeStats() const
+{
+    return m_bake_stats;
+}
+
+void aiContext::gatherNodesRecursive(aiObject *n)
+{
+    m_load_progress += (int)n->getNumChildren();
+    n->eachChild([this](aiObject& child) {
+        gatherNodesRecursive(&child);
+    });
 }
 
 void aiContext::reset()
 {
     m_top_node.reset();
     m_timesamplings.clear();
+    m_bake_stats = aiBakeStats();
     m_archive.reset();
+    m_shared_archive.reset();
 
     m_path.clear();
     for (auto s : m_streams)
@@ -325,7 +605,58 @@ void aiContext::reset()
     // m_config is not reset intentionally
 }
 
-bool aiContext::load(const char *in_path)
+bool aiContext::load(const char *path)
+{
+    waitLoad();
+    m_load_progress = 0;
+    m_load_state = aiLoadState::Loading;
+    bool ret = loadBody(path);
+    m_load_state = ret ? aiLoadState::Succeeded : aiLoadState::Failed;
+    return ret;
+}
+
+void aiContext::loadAsync(const char *path)
+{
+    waitLoad();
+    m_load_progress = 0;
+    m_load_state = aiLoadState::Loading;
+
+    std::string path_copy = path ? path : "";
+    m_async_load = std::async(std::launch::async, [this, path_copy]() {
+        bool ret = false;
+        try
+        {
+            ret = loadBody(path_copy.c_str());
+        }
+        catch (...)
+        {
+            // there is no caller to propagate to. report as a failure.
+            DebugLog("aiContext::loadAsync: exception while loading %s", path_copy.c_str());
+            reset();
+        }
+        m_load_state = ret ? aiLoadState::Succeeded : aiLoadState::Failed;
+        return ret;
+    });
+}
+
+bool aiContext::waitLoad()
+{
+    if (m_async_load.valid())
+        m_async_load.get();
+    return m_load_state == aiLoadState::Succeeded;
+}
+
+aiLoadState aiContext::getLoadState() const
+{
+    return m_load_state;
+}
+
+int aiContext::getLoadProgress() const
+{
+    return m_load_progress;
+}
+
+bool aiContext::loadBody(const char *in_path)
 {
     auto path = NormalizePath(in_path);
     auto wpath = L(in_path);
@@ -344,26 +675,68 @@ bool aiContext::load(const char *in_path)
     }
 
     m_path = path;
+    if (m_config.share_archives)
+    {
+        m_shared_archive = aiContextManager::findArchive(m_path);
+        if (m_shared_archive)
+        {
+            DebugLog("Sharing the archive opened by another context");
+            m_archive = m_shared_archive->getArchive();
+            m_isHDF5 = false;
+        }
+    }
+
     if (!m_archive.valid())
     {
         try
         {
             // Abc::IArchive doesn't accept wide string path. so create file stream with wide string path and pass it.
             // (VisualC++'s std::ifstream accepts wide string)
-            m_streams.push_back(
+            // Ogawa locks each stream while reading, so concurrent readers (parallel update, prefetch) need several streams.
+            int num_streams = m_config.stream_count > 0 ? m_config.stream_count : aiTaskPool::getInstance().getConcurrency();
+#ifndef WIN32
+            mmapFilePtr mapping;
+#endif
+            for (int si = 0; si < num_streams; ++si)
+            {
+                std::istream *stream = nullptr;
 #ifdef WIN32
-                new lockFreeIStream(wpath.c_str())
-#elif __linux__
-                new std::ifstream(in_path, std::ios::in | std::ios::binary)
+                stream = new lockFreeIStream(wpath.c_str());
 #else
-                new std::ifstream(path.c_str(), std::ios::in | std::ios::binary)
+    #ifdef __linux__
+                const char *native_path = in_path;
+    #else
+                const char *native_path = path.c_str();
+    #endif
+                if (m_config.use_mmap)
+                {
+                    if (!mapping)
+                        mapping = std::make_shared<mmapFile>(native_path);
+                    stream = new mmapIStream(mapping);
+                    if (!stream->good())
+                    {
+                        DebugLog("Unable to map %s. fall back to std::ifstream", native_path);
+                        delete stream;
+                        stream = nullptr;
+                    }
+                }
+                if (!stream)
+                    stream = new std::ifstream(native_path, std::ios::in | std::ios::binary);
 #endif
-            );
+                m_streams.push_back(stream);
+            }
 
             Alembic::AbcCoreOgawa::ReadArchive archive_reader(m_streams);
             m_archive = Abc::IArchive(archive_reader(m_path), Abc::kWrapExisting, Abc::ErrorHandler::kThrowPolicy);
             DebugLog("Successfully opened Ogawa archive");
             m_isHDF5 = false;
+
+            if (m_config.share_archives)
+            {
+                // the shared archive takes the streams
+                m_shared_archive.reset(new aiArchive(m_path, m_streams, m_archive));
+                aiContextManager::addArchive(m_shared_archive);
+            }
         }
         catch (Alembic::Util::Exception e)
         {
@@ -414,14 +787,26 @@ bool aiContext::load(const char *in_path)
     {
         abcObject abc_top = m_archive.getTop();
         m_top_node.reset(new aiObject(this, nullptr, abc_top));
-        gatherNodesRecursive(m_top_node.get());
+        // with lazy_load, nodes are created when they are first accessed and only those are updated
+        if (!m_config.lazy_load)
+            gatherNodesRecursive(m_top_node.get());
 
         m_timesamplings.clear();
-        auto num_time_samplings = (int)m_archive.getNumTimeSamplings();
-        for (int i = 0; i < num_time_samplings; ++i)
+        if (m_shared_archive)
         {
-            m_timesamplings.emplace_back(aiCreateTimeSampling(m_archive, i));
+            m_timesamplings = m_shared_archive->getTimeSamplings();
         }
+        else
+        {
+            auto num_time_samplings = (int)m_archive.getNumTimeSamplings();
+            for (int i = 0; i < num_time_samplings; ++i)
+            {
+                m_timesamplings.emplace_back(aiCreateTimeSampling(m_archive, i));
+            }
+        }
+
+        if (m_config.prebake_samples)
+            bakeSamples();
         return true;
     }
     else
@@ -436,12 +821,33 @@ aiObject* aiContext::getTopObject() const
     return m_top_node.get();
 }
 
+// a child is only updated after its parent, every other node runs independently.
+static void UpdateChildrenAsync(aiTaskGroup& group, aiObject& parent, const abcSampleSelector& ss)
+{
+    parent.eachChild([&group, &ss](aiObject& child) {
+        aiObject *c = &child;
+        group.run([&group, c, ss]() {
+            c->updateSample(ss);
+            UpdateChildrenAsync(group, *c, ss);
+        });
+    });
+}
+
 void aiContext::updateSamples(double time)
 {
     auto ss = aiTimeToSampleSelector(time);
-    eachNodes([ss](aiObject& o) {
-        o.updateSample(ss);
-    });
+    if (m_config.parallel_update && m_top_node)
+    {
+        aiTaskGroup group;
+        UpdateChildrenAsync(group, *m_top_node, ss);
+        group.wait();
+    }
+    else
+    {
+        eachNodes([ss](aiObject& o) {
+            o.updateSample(ss);
+        });
+    }
 }
 
 
@@ -29,6 +29,35 @@ class aiObject;
 #include "aiTimeSampling.h"
 
 
+// an opened archive and the data derived from it that never changes.
+// shared by all contexts that load the same path (see aiConfig::share_archives).
+class aiArchive
+{
+public:
+    aiArchive(const std::string& path, std::vector<std::istream*>& streams, Abc::IArchive archive);
+    ~aiArchive();
+
+    const std::string& getPath() const;
+    Abc::IArchive getArchive() const;
+    const std::vector<aiTimeSamplingPtr>& getTimeSamplings() const;
+
+    // cooked data that doesn't vary over time. the key must include everything that affects the data (object path, config).
+    // the data must not be modified once it is added.
+    std::shared_ptr<void> findConstantData(const std::string& key);
+    void addConstantData(const std::string& key, const std::shared_ptr<void>& data);
+
+private:
+    std::string m_path;
+    std::vector<std::istream*> m_streams;
+    Abc::IArchive m_archive;
+    std::vector<aiTimeSamplingPtr> m_timesamplings;
+
+    std::mutex m_mutex;
+    std::map<std::string, std::shared_ptr<void>> m_constant_data;
+};
+using aiArchivePtr = std::shared_ptr<aiArchive>;
+
+
 class aiContextManager
 {
 public:
@@ -36,10 +65,15 @@ public:
     static void destroyContext(int uid);
     static void destroyContextsWithPath(const char* assetPath);
 
+    static aiArchivePtr findArchive(const std::string& path);
+    static void addArchive(const aiArchivePtr& archive);
+
 private:
     ~aiContextManager();
 
     using ContextPtr = std::unique_ptr<aiContext>;
+    std::mutex m_archives_mutex;
+    std::map<std::string, std::weak_ptr<aiArchive>> m_archives;
     std::map<int, ContextPtr> m_contexts;
     static aiContextManager s_instance;
 };
@@ -52,6 +86,10 @@ public:
     ~aiContext();
 
     bool load(const char *path);
+    void loadAsync(const char *path);
+    bool waitLoad();
+    aiLoadState getLoadState() const;
+    int getLoadProgress() const; // number of nodes gathered so far
 
     const aiConfig& getConfig() const;
     void setConfig(const aiConfig &config);
@@ -60,6 +98,7 @@ public:
     void updateSamples(double time);
 
     Abc::IArchive getArchive() const;
+    aiArchive* getSharedArchive() const;
     const std::string& getPath() const;
     int getUid() const;
 
@@ -72,22 +111,45 @@ public:
 
     bool getIsHDF5() const { return m_isHDF5; }
 
+    // accounting of the schemas' sample caches. aiConfig::sample_cache_size is the budget for the whole context.
+    void addSampleCacheUsage(int64_t bytes, int count);
+    int64_t getSampleCacheUsage() const;
+    void countSampleCacheAccess(bool hit);
+    void getSampleCacheStats(aiSampleCacheStats& dst) const;
+
+    // aiConfig::prebake_samples. reads and cooks all samples of all schemas in parallel.
+    void bakeSamples();
+    const aiBakeStats& getBakeStats() const;
+
     template<class F>
     void eachNodes(const F &f);
 
 private:
-    static void gatherNodesRecursive(aiObject *n);
+    bool loadBody(const char *path);
+    void gatherNodesRecursive(aiObject *n);
     void reset();
 
     std::string m_path;
     std::vector<std::istream*> m_streams;
 
+    aiArchivePtr m_shared_archive;
     Abc::IArchive m_archive;
     std::unique_ptr<aiObject> m_top_node;
     std::vector<aiTimeSamplingPtr> m_timesamplings;
     int m_uid = 0;
     aiConfig m_config;
 
+    std::future<bool> m_async_load;
+    std::atomic<aiLoadState> m_load_state;
+    std::atomic<int> m_load_progress;
+
+    std::atomic<int64_t> m_cache_usage;
+    std::atomic<int64_t> m_cache_hits;
+    std::atomic<int64_t> m_cache_misses;
+    std::atomic<int> m_cache_sample_count;
+
+    aiBakeStats m_bake_stats;
+
     bool m_isHDF5;
 };
 
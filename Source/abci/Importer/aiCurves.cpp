@@ -7,6 +7,11 @@ aiCurvesSample::aiCurvesSample(aiCurves *schema) : super(schema)
 {
 }
 
+size_t aiCurvesSample::getMemoryUsage() const
+{
+    return GetMemoryUsage(m_positions, m_positions2, m_positions_prev, m_numVertices, m_uvs, m_uvs2, m_widths, m_widths2, m_velocities);
+}
+
 void aiCurvesSample::getSummary(aiCurvesSampleSummary &dst)
 {
     dst.positionCount = m_positions.size();
@@ -49,6 +54,11 @@ aiCurves::aiCurves(aiObject *parent, const abcObject &abc) : super(parent, abc)
     updateSummary();
 }
 
+aiCurves::~aiCurves()
+{
+    waitPrefetch();
+}
+
 aiCurvesSample *aiCurves::newSample()
 {
     return new Sample(this);
@@ -104,6 +114,19 @@ void aiCurves::readSampleBody(aiCurvesSample &sample, uint64_t idx)
 
 }
 
+bool aiCurves::swapReadData(aiCurvesSample &dst, aiCurvesSample &src)
+{
+    std::swap(dst.m_position_sp, src.m_position_sp);
+    std::swap(dst.m_position_sp2, src.m_position_sp2);
+    std::swap(dst.m_numVertices_sp, src.m_numVertices_sp);
+    std::swap(dst.m_uvs_sp, src.m_uvs_sp);
+    std::swap(dst.m_uvs_sp2, src.m_uvs_sp2);
+    std::swap(dst.m_widths_sp, src.m_widths_sp);
+    std::swap(dst.m_widths_sp2, src.m_widths_sp2);
+    std::swap(dst.m_velocities_sp, src.m_velocities_sp);
+    return true;
+}
+
 void aiCurves::cookSampleBody(aiCurvesSample &sample)
 {
 	auto& config = getConfig();
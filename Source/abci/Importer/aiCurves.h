@@ -18,6 +18,7 @@ class aiCurvesSample : public aiSample
 public:
     aiCurvesSample(aiCurves *schema);
     void getSummary(aiCurvesSampleSummary &dst);
+    size_t getMemoryUsage() const override;
 
     ~aiCurvesSample(){}
     Abc::P3fArraySamplePtr m_position_sp,m_position_sp2;
@@ -50,11 +51,12 @@ class aiCurves : public aiTSchema<aiCurvesTraits>
     using super = aiTSchema<aiCurvesTraits>;
 public:
     aiCurves(aiObject *parent, const abcObject &abc);
-    ~aiCurves() override {};
+    ~aiCurves() override;
 
     Sample* newSample() override;
     void readSampleBody(Sample& sample, uint64_t idx) override;
     void cookSampleBody(Sample& sample) override;
+    bool swapReadData(Sample& dst, Sample& src) override;
     const aiCurvesSummaryInternal& getSummary() const {return m_summary;}
 private:
     void updateSummary();
@@ -3,3 +3,4 @@
 #include "aiLogger.h"
 #include "aiIntrusiveArray.h"
 #include "RawVector.h"
+#include "aiTaskPool.h"
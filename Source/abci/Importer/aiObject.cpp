@@ -105,6 +105,20 @@ aiObject* aiObject::newChild(const abcObject &abc)
     return ret;
 }
 
+// creates the direct children. with aiConfig::lazy_load, this is deferred until the children are first accessed.
+void aiObject::gatherChildren()
+{
+    if (m_children_gathered)
+        return;
+    m_children_gathered = true;
+
+    size_t num_children = m_abc.getNumChildren();
+    for (size_t i = 0; i < num_children; ++i)
+    {
+        newChild(m_abc.getChild(i));
+    }
+}
+
 void aiObject::removeChild(aiObject *c)
 {
     if (c == nullptr) { return; }
@@ -122,8 +136,8 @@ const aiConfig& aiObject::getConfig() const { return m_ctx->getConfig(); }
 abcObject&  aiObject::getAbcObject()        { return m_abc; }
 const char* aiObject::getName() const       { return m_name.c_str(); }
 const char* aiObject::getFullName() const   { return m_fullname.c_str(); }
-uint32_t    aiObject::getNumChildren() const{ return (uint32_t)m_children.size(); }
-aiObject*   aiObject::getChild(int i)       { return m_children[i].get(); }
+uint32_t    aiObject::getNumChildren()      { gatherChildren(); return (uint32_t)m_children.size(); }
+aiObject*   aiObject::getChild(int i)       { gatherChildren(); return m_children[i].get(); }
 aiObject*   aiObject::getParent() const     { return m_parent; }
 void        aiObject::setEnabled(bool v)    { m_enabled = v; }
 
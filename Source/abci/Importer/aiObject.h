@@ -14,7 +14,7 @@ public:
 
     const char* getName() const;
     const char* getFullName() const;
-    uint32_t    getNumChildren() const;
+    uint32_t    getNumChildren();
     aiObject*   getChild(int i);
     aiObject*   getParent() const;
     void        setEnabled(bool v);
@@ -47,6 +47,7 @@ public:
     abcObject&  getAbcObject();
     aiObject*   newChild(const abcObject &abc);
     void        removeChild(aiObject *c);
+    void        gatherChildren();
 
 protected:
     using ObjectPtr = std::unique_ptr<aiObject>;
@@ -58,6 +59,7 @@ protected:
     abcObject   m_abc;
     aiObject    *m_parent = nullptr;
     std::vector<ObjectPtr> m_children;
+    bool m_children_gathered = false;
     std::string m_name;     //
     std::string m_fullname; // sanitized
     bool m_enabled = true;
@@ -28,6 +28,11 @@ aiPointsSample::~aiPointsSample()
 {
 }
 
+size_t aiPointsSample::getMemoryUsage() const
+{
+    return GetMemoryUsage(m_sort_data, m_points, m_points2, m_points_int, m_points_prev, m_velocities, m_ids);
+}
+
 void aiPointsSample::fillData(aiPointsData &data)
 {
     data.visibility = visibility;
@@ -69,6 +74,7 @@ aiPoints::aiPoints(aiObject *parent, const abcObject &abc)
 aiPoints::~aiPoints()
 {
     waitAsync();
+    waitPrefetch();
 }
 
 void aiPoints::updateSummary()
@@ -141,6 +147,15 @@ void aiPoints::readSampleBody(Sample & sample, uint64_t idx)
     }
 }
 
+bool aiPoints::swapReadData(Sample& dst, Sample& src)
+{
+    std::swap(dst.m_points_sp, src.m_points_sp);
+    std::swap(dst.m_points_sp2, src.m_points_sp2);
+    std::swap(dst.m_velocities_sp, src.m_velocities_sp);
+    std::swap(dst.m_ids_sp, src.m_ids_sp);
+    return true;
+}
+
 void aiPoints::cookSampleBody(Sample& sample)
 {
     auto& summary = getSummary();
@@ -13,6 +13,7 @@ class aiPointsSample : public aiSample
 public:
     aiPointsSample(aiPoints *schema);
     ~aiPointsSample();
+    size_t getMemoryUsage() const override;
     void fillData(aiPointsData &dst);
     void getSummary(aiPointsSampleSummary &dst);
 
@@ -48,6 +49,7 @@ public:
 
     Sample* newSample() override;
     void readSampleBody(Sample& sample, uint64_t idx) override;
+    bool swapReadData(Sample& dst, Sample& src) override;
     void cookSampleBody(Sample& sample) override;
 
     void setSort(bool v);
@@ -6,6 +6,7 @@
 #include "aiPolyMesh.h"
 #include "../Foundation/aiMisc.h"
 #include "../Foundation/aiMath.h"
+#include "aiUtils.h"
 
 
 template<class Container>
@@ -46,6 +47,81 @@ inline void Remap(RawVector<T>& dst, const AbcArraySample& src, const RawVector<
     }
 }
 
+// remap + swap handedness + scale in one pass
+template<class AbcArraySample>
+inline void RemapTransform(RawVector<abcV3>& dst, const AbcArraySample& src, const RawVector<int>& indices, const abcV3& scale)
+{
+    auto src_data = (const abcV3*)src.get();
+    if (!src_data)
+    {
+        dst.clear();
+        return;
+    }
+    if (indices.empty())
+    {
+        dst.resize_discard(src.size());
+        RemapTransform(dst.data(), src_data, nullptr, (int)dst.size(), scale);
+    }
+    else
+    {
+        dst.resize_discard(indices.size());
+        RemapTransform(dst.data(), src_data, indices.data(), (int)dst.size(), scale);
+    }
+}
+
+static inline abcV3 GetTransformScale(const aiConfig& config, float scale)
+{
+    return abcV3(config.swap_handedness ? -scale : scale, scale, scale);
+}
+
+// tangents of all vertices of the refined topology
+static void GenerateVertexTangents(abcV4 *dst, MikkTangentsGenerator& generator, const aiMeshTopology& topology,
+    const abcV3 *points, const abcV2 *uv, const abcV3 *normals, int num_points, const aiConfig& config)
+{
+    const auto& indices = topology.m_refiner.new_indices_tri;
+    if (config.tangents_mode == TangentsMode::MikkTSpace)
+        generator.generate(dst, points, uv, normals, indices, topology.m_tangents_connection);
+    else
+        GenerateTangents(dst, points, uv, normals, indices.data(), num_points, (int)indices.size() / 3);
+}
+
+// computed normals of all vertices of the refined topology
+static void GenerateNormals(abcV3 *dst, PointNormalsGenerator& generator, const aiMeshTopology& topology,
+    const abcV3 *points, const aiConfig& config)
+{
+    // the smoothing angle only decides the split at refine time. after that, normals are smoothed over the normal
+    // groups, so a vertex that was not split never gets a one sided normal when its faces bend later.
+    bool hard_edges = PointNormalsGenerator::splitsHardEdges(config.smoothing_angle);
+    generator.generate(dst, hard_edges ? topology.m_remap_normal_groups : topology.m_remap_points,
+        topology.m_face_table, { topology.m_indices_sp->get(), topology.m_indices_sp->size() },
+        points, hard_edges ? topology.m_normal_groups : topology.m_refiner.connection,
+        config.normals_weighting == NormalsWeighting::Angle);
+}
+
+// groups the corners of each point by their normal, as the refiner merges them. returns the number of groups.
+static int GroupCornersByNormal(RawVector<int>& dst, const RawVector<abcV3>& corner_normals, const MeshConnectionInfo& connection)
+{
+    dst.resize_discard(corner_normals.size());
+    int num_groups = 0;
+    int num_points = (int)connection.v2f_counts.size();
+    for (int pi = 0; pi < num_points; ++pi)
+    {
+        int count = connection.v2f_counts[pi];
+        const int *corners = connection.v2f_indices.data() + connection.v2f_offsets[pi];
+        for (int i = 0; i < count; ++i)
+        {
+            int group = -1;
+            for (int j = 0; j < i && group == -1; ++j)
+            {
+                if (corner_normals[corners[j]] == corner_normals[corners[i]])
+                    group = dst[corners[j]];
+            }
+            dst[corners[i]] = group != -1 ? group : num_groups++;
+        }
+    }
+    return num_groups;
+}
+
 template<class T>
 inline void Lerp(RawVector<T>& dst, const RawVector<T>& src1, const RawVector<T>& src2, float w)
 {
@@ -71,13 +147,19 @@ void aiMeshTopology::clear()
     m_refiner.clear();
     m_remap_points.clear();
     m_remap_normals.clear();
+    m_normal_groups.clear();
+    m_remap_normal_groups.clear();
     m_remap_uv0.clear();
     m_remap_uv1.clear();
     m_remap_rgba.clear();
     m_remap_rgb.clear();
+    m_face_table.clear();
+    m_tangents_connection.clear();
 
     m_vertex_count = 0;
     m_index_count = 0;
+    m_hash = 0;
+    m_refined = false;
 }
 
 int aiMeshTopology::getSplitCount() const
@@ -120,6 +202,79 @@ aiPolyMeshSample::~aiPolyMeshSample()
 {
 }
 
+size_t aiPolyMeshSample::getMemoryUsage() const
+{
+    // the topology is shared with the schema. array samples are released when the sample is stored
+    // (see releaseReadData()). only count what the sample owns.
+    return GetMemoryUsage(
+        m_points, m_points2, m_points_int, m_velocities, m_points_q.data, m_points2_q.data,
+        m_uv0, m_uv02, m_uv0_int, m_uv1, m_uv12, m_uv1_int,
+        m_normals, m_normals2, m_normals_int, m_tangents,
+        m_rgba, m_rgba2, m_rgba_int, m_rgb, m_rgb2, m_rgb_int, m_rgb4);
+}
+
+static void ReleaseMemory(RawVector<abcV3>& v)
+{
+    v.clear();
+    v.shrink_to_fit();
+}
+
+bool aiPolyMeshSample::compressPoints(const KeyPointsPtr& key)
+{
+    if (m_points_compressed)
+        return true;
+
+    size_t n = key->size();
+    if (m_points.size() != n || (!m_points2.empty() && m_points2.size() != n))
+        return false;
+
+    // the source points don't change until the next read. encode them only once.
+    if (m_key_points != key)
+    {
+        m_key_points = key;
+        m_points_q.data.resize_discard(n * 3);
+        QuantizeDelta(m_points_q.data.data(), m_points_q.offset, m_points_q.step, m_points.data(), key->data(), (int)n);
+        m_points2_q.data.resize_discard(m_points2.size() * 3);
+        QuantizeDelta(m_points2_q.data.data(), m_points2_q.offset, m_points2_q.step, m_points2.data(), key->data(), (int)m_points2.size());
+    }
+
+    ReleaseMemory(m_points);
+    ReleaseMemory(m_points2);
+    m_cooked_keys[KeyPoints].reset();
+    m_cooked_keys[KeyPoints2].reset();
+    // the previous interpolated points are kept by the schema. only the scratch of the interpolation goes here.
+    ReleaseMemory(m_points_int);
+    m_points_ref.reset();
+    m_points_compressed = true;
+    return true;
+}
+
+void aiPolyMeshSample::decompressPoints()
+{
+    if (!m_points_compressed)
+        return;
+
+    auto& key = *m_key_points;
+    m_points.resize_discard(key.size());
+    DequantizeDelta(m_points.data(), m_points_q.data.data(), key.data(), m_points_q.offset, m_points_q.step, (int)key.size());
+    if (!m_points2_q.data.empty())
+    {
+        m_points2.resize_discard(key.size());
+        DequantizeDelta(m_points2.data(), m_points2_q.data.data(), key.data(), m_points2_q.offset, m_points2_q.step, (int)key.size());
+    }
+    // cookSampleBody() overrides this when interpolating
+    m_points_ref = m_points;
+    m_points_compressed = false;
+}
+
+void aiPolyMeshSample::discardCompressedPoints()
+{
+    m_key_points.reset();
+    m_points_q.data.clear();
+    m_points2_q.data.clear();
+    m_points_compressed = false;
+}
+
 void aiPolyMeshSample::reset()
 {
     m_points_sp.reset(); m_points_sp2.reset();
@@ -128,6 +283,8 @@ void aiPolyMeshSample::reset()
     m_uv0_sp.reset(); m_uv1_sp.reset();
     m_rgba_sp.reset();
     m_rgb_sp.reset();
+    for (auto& key : m_read_keys)
+        key.reset();
 
     m_points_ref.reset();
     m_velocities_ref.reset();
@@ -137,6 +294,23 @@ void aiPolyMeshSample::reset()
     m_tangents_ref.reset();
     m_rgba_ref.reset();
     m_rgb_ref.reset();
+    m_rgb4_ref.reset();
+    m_direct_streams = 0;
+}
+
+void aiPolyMeshSample::releaseReadData()
+{
+    m_points_sp.reset(); m_points_sp2.reset();
+    m_velocities_sp.reset();
+    m_normals_sp.reset(); m_normals_sp2.reset();
+    m_uv0_sp.reset(); m_uv0_sp2.reset();
+    m_uv1_sp.reset(); m_uv1_sp2.reset();
+    m_rgba_sp.reset(); m_rgba_sp2.reset();
+    m_rgb_sp.reset(); m_rgb_sp2.reset();
+
+    // a matching key would skip the fetch on the next read into this sample
+    for (auto& key : m_read_keys)
+        key.reset();
 }
 
 void aiPolyMeshSample::getSummary(aiMeshSampleSummary &dst) const
@@ -189,51 +363,83 @@ static inline void copy_or_clear(T* dst, const IArray<T>& src, const MeshRefiner
     }
 }
 
-template<class T1, class T2>
-static inline void copy_or_clear_3_to_4(T1* dst, const IArray<T2>& src, const MeshRefiner::Split& split)
+// direct: the destination buffer the stream was interpolated into, if any
+template<class T>
+static inline void copy_or_clear(T* dst, const IArray<T>& src, const MeshRefiner::Split& split, const T* direct)
 {
-    if (dst)
+    if (direct)
     {
-        if (!src.empty()) {
-            std::vector<T1> abc4(split.vertex_count);
-            std::transform(src.begin(), src.end(), abc4.begin(), [](const T2& c){ return T1{c.x, c.y, c.z, 1.f}; });
-            memcpy(dst, abc4.data() + split.vertex_offset, sizeof(T1) * split.vertex_count);
-        } else {
-            memset(dst, 0, split.vertex_count * sizeof(T1));
-        }
+        if (dst && dst != direct)
+            memcpy(dst, direct, split.vertex_count * sizeof(T));
+    }
+    else
+    {
+        copy_or_clear(dst, src, split);
     }
 }
 
 void aiPolyMeshSample::fillSplitVertices(int split_index, aiPolyMeshData &data) const
 {
-    auto& schema = *dynamic_cast<schema_t*>(getSchema());
-    auto& summary = schema.getSummary();
+    for (int stream = 0; stream < FillStreamCount; ++stream)
+        fillSplitStream(split_index, stream, data);
+}
+
+void aiPolyMeshSample::fillSplitStream(int split_index, int stream, aiPolyMeshData &data) const
+{
     auto& splits = m_topology->m_refiner.splits;
     if (split_index < 0 || size_t(split_index) >= splits.size() || splits[split_index].vertex_count == 0)
         return;
 
-    auto& refiner = m_topology->m_refiner;
-    auto& split = refiner.splits[split_index];
+    auto& split = splits[split_index];
 
-    if (data.points)
-    {
-        m_points_ref.copy_to(data.points, split.vertex_count, split.vertex_offset);
+    static const aiPolyMeshData s_no_direct = aiPolyMeshData();
+    auto& direct = m_direct_streams ? m_direct_buffers[split_index] : s_no_direct;
+    auto direct_stream = [this](int flag, void *ptr) -> void* { return (m_direct_streams & flag) ? ptr : nullptr; };
 
-        // bounds
-        abcV3 bbmin, bbmax;
-        MinMax(bbmin, bbmax, data.points, split.vertex_count);
-        data.center = (bbmin + bbmax) * 0.5f;
-        data.extents = bbmax - bbmin;
+    switch (stream)
+    {
+    case FillPoints:
+        if (data.points)
+        {
+            // copy + bounds
+            auto src = (const abcV3*)direct_stream(DirectPoints, direct.points);
+            if (!src && !m_points_ref.empty())
+                src = m_points_ref.data() + split.vertex_offset;
+
+            abcV3 bbmin(0.0f, 0.0f, 0.0f), bbmax(0.0f, 0.0f, 0.0f);
+            if (!src)
+                memset(data.points, 0, split.vertex_count * sizeof(abcV3));
+            else if (src == data.points)
+                MinMax(bbmin, bbmax, data.points, split.vertex_count);
+            else
+                CopyMinMax(data.points, bbmin, bbmax, src, split.vertex_count);
+            data.center = (bbmin + bbmax) * 0.5f;
+            data.extents = bbmax - bbmin;
+        }
+        break;
+    case FillVelocities:
+        // note: velocity can be empty even if summary.has_velocities is true (compute is enabled & first frame)
+        copy_or_clear(data.velocities, m_velocities_ref, split, (abcV3*)direct_stream(DirectVelocities, direct.velocities));
+        break;
+    case FillNormals:
+        copy_or_clear(data.normals, m_normals_ref, split, (abcV3*)direct_stream(DirectNormals, direct.normals));
+        break;
+    case FillTangents:
+        copy_or_clear(data.tangents, m_tangents_ref, split);
+        break;
+    case FillUV0:
+        copy_or_clear(data.uv0, m_uv0_ref, split, (abcV2*)direct_stream(DirectUV0, direct.uv0));
+        break;
+    case FillUV1:
+        copy_or_clear(data.uv1, m_uv1_ref, split, (abcV2*)direct_stream(DirectUV1, direct.uv1));
+        break;
+    case FillRgba:
+        copy_or_clear((abcC4*)data.rgba, m_rgba_ref, split, (abcC4*)direct_stream(DirectRgba, direct.rgba));
+        break;
+    case FillRgb:
+        copy_or_clear((abcC4*)data.rgb, m_rgb4_ref, split);
+        break;
     }
-
-    // note: velocity can be empty even if summary.has_velocities is true (compute is enabled & first frame)
-    copy_or_clear(data.velocities, m_velocities_ref, split);
-    copy_or_clear(data.normals, m_normals_ref, split);
-    copy_or_clear(data.tangents, m_tangents_ref, split);
-    copy_or_clear(data.uv0, m_uv0_ref, split);
-    copy_or_clear(data.uv1, m_uv1_ref, split);
-    copy_or_clear((abcC4*)data.rgba, m_rgba_ref, split);
-    copy_or_clear_3_to_4<abcC4, abcC3>((abcC4*)data.rgb, m_rgb_ref, split);
 }
 
 void aiPolyMeshSample::fillSubmeshIndices(int submesh_index, aiSubmeshData &data) const
@@ -249,15 +455,43 @@ void aiPolyMeshSample::fillSubmeshIndices(int submesh_index, aiSubmeshData &data
 void aiPolyMeshSample::fillVertexBuffer(aiPolyMeshData * vbs, aiSubmeshData * ibs)
 {
     auto &refiner = m_topology->m_refiner;
-    for (int spi = 0; spi < (int) refiner.splits.size(); ++spi)
-        fillSplitVertices(spi, vbs[spi]);
-    for (int smi = 0; smi < (int) refiner.submeshes.size(); ++smi)
-        fillSubmeshIndices(smi, ibs[smi]);
+    int num_splits = (int)refiner.splits.size();
+    int num_submeshes = (int)refiner.submeshes.size();
+
+    // each split x stream and each submesh is a task. small meshes are not worth the overhead.
+    int num_stream_tasks = num_splits * FillStreamCount;
+    int num_tasks = num_stream_tasks + num_submeshes;
+    int grain = m_topology->getVertexCount() < fill_parallel_threshold ? num_tasks : 1;
+    aiParallelFor(0, num_tasks, grain, [this, vbs, ibs, num_stream_tasks](int begin, int end) {
+        for (int ti = begin; ti < end; ++ti)
+        {
+            if (ti < num_stream_tasks)
+                fillSplitStream(ti / FillStreamCount, ti % FillStreamCount, vbs[ti / FillStreamCount]);
+            else
+                fillSubmeshIndices(ti - num_stream_tasks, ibs[ti - num_stream_tasks]);
+        }
+    });
 }
 
 aiPolyMesh::aiPolyMesh(aiObject *parent, const abcObject &abc)
     : super(parent, abc)
+    , m_constants(new aiMeshConstantData())
+{
+    for (auto& n : m_read_skips)
+        n = 0;
+    for (auto& n : m_remap_skips)
+        n = 0;
+}
+
+aiPolyMesh::~aiPolyMesh()
+{
+    waitPrefetch();
+}
+
+void aiPolyMesh::setupBody()
 {
+    super::setupBody();
+
     // find vertex color and additional uv params
     auto geom_params = m_schema.getArbGeomParams();
     if (geom_params.valid())
@@ -302,16 +536,67 @@ aiPolyMesh::aiPolyMesh(aiObject *parent, const abcObject &abc)
     updateSummary();
 }
 
-aiPolyMesh::~aiPolyMesh()
+// true if all samples of the array property have the same content.
+// compares the digests stored in the archive (Ogawa array keys) instead of reading the samples.
+template<class ArrayProperty>
+static bool IsArrayPropertyConstant(const ArrayProperty& prop)
 {
+    if (!prop.valid() || prop.isConstant())
+        return true;
+
+    AbcCoreAbstract::ArraySampleKey first;
+    if (!prop.getKey(first, aiIndexToSampleSelector(0)))
+        return false;
+
+    size_t num_samples = prop.getNumSamples();
+    for (size_t i = 1; i < num_samples; ++i)
+    {
+        AbcCoreAbstract::ArraySampleKey key;
+        if (!prop.getKey(key, aiIndexToSampleSelector((int64_t)i)) || !(key == first))
+            return false;
+    }
+    return true;
+}
+
+template<class GeomParam>
+static bool IsGeomParamIndicesConstant(const GeomParam& param)
+{
+    return !param.valid() || !param.isIndexed() || IsArrayPropertyConstant(param.getIndexProperty());
+}
+
+bool aiPolyMesh::isTopologyActuallyConstant()
+{
+    // same conditions as the homogeneous topology path: the remap tables are made from the first sample.
+    if (!IsArrayPropertyConstant(m_schema.getFaceCountsProperty()) ||
+        !IsArrayPropertyConstant(m_schema.getFaceIndicesProperty()))
+        return false;
+
+    for (auto& fs : m_facesets)
+    {
+        if (!fs.isConstant())
+            return false;
+    }
+
+    return IsGeomParamIndicesConstant(m_schema.getNormalsParam()) &&
+        IsGeomParamIndicesConstant(m_schema.getUVsParam()) &&
+        IsGeomParamIndicesConstant(m_uv1_param) &&
+        IsGeomParamIndicesConstant(m_rgba_param) &&
+        IsGeomParamIndicesConstant(m_rgb_param);
 }
 
 void aiPolyMesh::updateSummary()
 {
-    m_varying_topology = (m_schema.getTopologyVariance() == AbcGeom::kHeterogeneousTopology);
     auto& summary = m_summary;
     auto& config = getConfig();
 
+    m_varying_topology = (m_schema.getTopologyVariance() == AbcGeom::kHeterogeneousTopology);
+    bool promoted = m_varying_topology && config.detect_constant_topology && isTopologyActuallyConstant();
+    if (promoted)
+    {
+        DebugLog("aiPolyMesh: %s is marked as heterogeneous but its topology is constant", m_abc.getFullName().c_str());
+        m_varying_topology = false;
+    }
+
     summary = {};
     m_constant = m_schema.isConstant();
 
@@ -321,7 +606,7 @@ void aiPolyMesh::updateSummary()
         m_constant = false;
     }
 
-    summary.topology_variance = (aiTopologyVariance)m_schema.getTopologyVariance();
+    summary.topology_variance = promoted ? aiTopologyVariance::Homogeneous : (aiTopologyVariance)m_schema.getTopologyVariance();
 
     // counts
     {
@@ -464,7 +749,7 @@ void aiPolyMesh::updateSummary()
     }
 
     // tangents
-    if (config.tangents_mode == TangentsMode::Compute && summary.has_normals && summary.has_uv0)
+    if (config.tangents_mode != TangentsMode::None && summary.has_normals && summary.has_uv0)
     {
         summary.has_tangents = true;
         summary.compute_tangents = true;
@@ -489,6 +774,7 @@ void aiPolyMesh::updateSummary()
 
 const aiMeshSummaryInternal& aiPolyMesh::getSummary() const
 {
+    setup();
     return m_summary;
 }
 
@@ -496,9 +782,22 @@ aiPolyMesh::Sample* aiPolyMesh::newSample()
 {
     if (!m_varying_topology)
     {
-        if (!m_shared_topology)
-            m_shared_topology.reset(new aiMeshTopology());
-        return new Sample(this, m_shared_topology);
+        if (!m_constants->topology)
+        {
+            // another context may have cooked this mesh already
+            auto archive = getContext()->getSharedArchive();
+            auto shared = archive ? std::static_pointer_cast<aiMeshConstantData>(archive->findConstantData(getConstantDataKey())) : nullptr;
+            if (shared)
+            {
+                m_constants = shared;
+                m_constants_shared = true;
+            }
+            else
+            {
+                m_constants->topology.reset(new aiMeshTopology());
+            }
+        }
+        return new Sample(this, m_constants->topology);
     }
     else
     {
@@ -506,17 +805,372 @@ aiPolyMesh::Sample* aiPolyMesh::newSample()
     }
 }
 
+std::string aiPolyMesh::getConstantDataKey() const
+{
+    // everything that affects the topology and the constant data
+    auto& config = getConfig();
+    char buf[256];
+    snprintf(buf, sizeof(buf), "|%d|%d|%d|%g|%g|%g|%d|%d%d%d%d%d%d",
+        (int)config.normals_mode, (int)config.normals_weighting, (int)config.tangents_mode, config.smoothing_angle,
+        config.scale_factor, config.vertex_motion_scale, config.split_unit,
+        (int)config.swap_handedness, (int)config.swap_face_winding, (int)config.interpolate_samples,
+        (int)config.import_point_polygon, (int)config.import_line_polygon, (int)config.import_triangle_polygon);
+    return m_abc.getFullName() + buf;
+}
+
+template<class GeomParamSample>
+static uint64_t HashAttribute(const GeomParamSample& sp, size_t num_indices, size_t num_points, uint64_t seed)
+{
+    if (!sp.valid())
+        return HashMemory(nullptr, 0, seed);
+
+    // same classification as onTopologyChange(). values of per-point attributes are always equal among the
+    // indices of a point, so they can't split vertices. others can, so their values are a part of the topology.
+    auto& vals = *sp.getVals();
+    bool own_indices = sp.isIndexed() && sp.getIndices()->size() == num_indices;
+    bool per_point = !own_indices && vals.size() != num_indices && vals.size() == num_points;
+
+    uint64_t header[] = { vals.size(), (uint64_t)own_indices, (uint64_t)per_point };
+    uint64_t h = HashMemory(header, sizeof(header), seed);
+    if (own_indices)
+        h = HashMemory(sp.getIndices()->get(), sp.getIndices()->size() * sizeof(uint32_t), h);
+    if (!per_point)
+        h = HashMemory(vals.get(), vals.size() * sizeof(*vals.get()), h);
+    return h;
+}
+
+uint64_t aiPolyMesh::getTopologyHash(const Sample& sample) const
+{
+    // everything onTopologyChange() depends on except point positions
+    auto& topology = *sample.m_topology;
+    size_t num_indices = topology.m_indices_sp ? topology.m_indices_sp->size() : 0;
+    size_t num_points = sample.m_points_sp ? sample.m_points_sp->size() : 0;
+
+    uint64_t sizes[] = { topology.m_counts_sp ? topology.m_counts_sp->size() : 0, num_indices, num_points };
+    uint64_t h = HashMemory(sizes, sizeof(sizes));
+    if (topology.m_counts_sp)
+        h = HashMemory(topology.m_counts_sp->get(), topology.m_counts_sp->size() * sizeof(int), h);
+    if (topology.m_indices_sp)
+        h = HashMemory(topology.m_indices_sp->get(), num_indices * sizeof(int), h);
+    for (auto& fsp : topology.m_faceset_sps)
+    {
+        auto faces = fsp.getFaces();
+        uint64_t n = faces ? faces->size() : 0;
+        h = HashMemory(&n, sizeof(n), h);
+        if (n)
+            h = HashMemory(faces->get(), n * sizeof(int), h);
+    }
+
+    h = HashAttribute(sample.m_normals_sp, num_indices, num_points, h);
+    h = HashAttribute(sample.m_uv0_sp, num_indices, num_points, h);
+    h = HashAttribute(sample.m_uv1_sp, num_indices, num_points, h);
+    h = HashAttribute(sample.m_rgba_sp, num_indices, num_points, h);
+    h = HashAttribute(sample.m_rgb_sp, num_indices, num_points, h);
+    return h;
+}
+
+bool aiPolyMesh::canCacheTopology() const
+{
+    // constant attributes are remapped into m_constants only once, for the topology refined then.
+    // a topology taken from the cache would skip onTopologyChange() and use them with the wrong layout.
+    auto& summary = getSummary();
+    return m_varying_topology && getConfig().topology_cache_size > 0 &&
+        !summary.constant_points && !summary.constant_velocities && !summary.constant_normals &&
+        !summary.constant_tangents && !summary.constant_uv0 && !summary.constant_uv1 &&
+        !summary.constant_rgba && !summary.constant_rgb;
+}
+
+void aiPolyMesh::storeTopologyToCache(const TopologyPtr& topology)
+{
+    auto& entry = m_topology_cache[topology->m_hash];
+    entry.topology = topology;
+    entry.last_use = ++m_topology_cache_clock;
+
+    int capacity = getConfig().topology_cache_size;
+    while ((int)m_topology_cache.size() > capacity)
+    {
+        auto lru = std::min_element(m_topology_cache.begin(), m_topology_cache.end(),
+            [](const std::pair<const uint64_t, CachedTopology>& a, const std::pair<const uint64_t, CachedTopology>& b) {
+                return a.second.last_use < b.second.last_use; });
+        m_topology_cache.erase(lru);
+    }
+}
+
+static void FetchArraySample(AbcGeom::IP3fArrayProperty& prop, Abc::P3fArraySamplePtr& dst, const abcSampleSelector& ss)
+{
+    prop.get(dst, ss);
+}
+
+template<class GeomParam>
+static void FetchArraySample(GeomParam& param, typename GeomParam::Sample& dst, const abcSampleSelector& ss)
+{
+    param.getIndexed(dst, ss);
+}
+
+static aiSampleKey GetSampleKey(AbcGeom::IP3fArrayProperty& prop, const abcSampleSelector& ss)
+{
+    aiSampleKey ret;
+    ret.valid = prop.getKey(ret.values, ss);
+    return ret;
+}
+
+template<class GeomParam>
+static aiSampleKey GetSampleKey(GeomParam& param, const abcSampleSelector& ss)
+{
+    aiSampleKey ret;
+    ret.valid = param.getValueProperty().getKey(ret.values, ss) &&
+        (!param.isIndexed() || param.getIndexProperty().getKey(ret.indices, ss));
+    return ret;
+}
+
+template<class Property, class ArraySample>
+void aiPolyMesh::readArraySample(Property& prop, ArraySample& dst, Sample& sample, int slot, const abcSampleSelector& ss)
+{
+    // dst still holds the array sample its key was taken from. skip the fetch if the new one has the same key.
+    auto& dst_key = sample.m_read_keys[slot];
+    if (getConfig().skip_unchanged_attributes)
+    {
+        aiSampleKey key = GetSampleKey(prop, ss);
+        if (key.matches(dst_key))
+        {
+            ++m_read_skips[slot / 2];
+            return;
+        }
+        dst_key = key;
+    }
+    else
+    {
+        dst_key.reset();
+    }
+    FetchArraySample(prop, dst, ss);
+}
+
+// the data remapped from the array sample in the slot is up to date if it was made from one with the same key
+bool aiPolyMesh::needsRemap(Sample& sample, int slot)
+{
+    auto& read = sample.m_read_keys[slot];
+    auto& cooked = sample.m_cooked_keys[slot];
+    if (read.matches(cooked))
+    {
+        ++m_remap_skips[slot / 2];
+        return false;
+    }
+    cooked = read;
+    return true;
+}
+
+void aiPolyMesh::getSkipStats(aiMeshSkipStats& dst) const
+{
+    dst.points_read_skips = m_read_skips[0];
+    dst.points_remap_skips = m_remap_skips[0];
+    dst.normals_read_skips = m_read_skips[1];
+    dst.normals_remap_skips = m_remap_skips[1];
+    dst.uv0_read_skips = m_read_skips[2];
+    dst.uv0_remap_skips = m_remap_skips[2];
+    dst.uv1_read_skips = m_read_skips[3];
+    dst.uv1_remap_skips = m_remap_skips[3];
+    dst.rgba_read_skips = m_read_skips[4];
+    dst.rgba_remap_skips = m_remap_skips[4];
+    dst.rgb_read_skips = m_read_skips[5];
+    dst.rgb_remap_skips = m_remap_skips[5];
+}
+
+// lerps src1 and src2 into the per split destination buffers
+template<class T, class Dst>
+static inline void LerpToSplits(std::vector<aiPolyMeshData>& dst, Dst* aiPolyMeshData::*member,
+    const RawVector<T>& src1, const RawVector<T>& src2, const RawVector<MeshRefiner::Split>& splits, float w)
+{
+    for (size_t spi = 0; spi < splits.size(); ++spi)
+    {
+        auto& split = splits[spi];
+        Lerp((T*)(dst[spi].*member), src1.data() + split.vertex_offset, src2.data() + split.vertex_offset,
+            split.vertex_count, w);
+    }
+}
+
+void aiPolyMesh::setDestinationBuffers(const aiPolyMeshData *vbs, int split_count)
+{
+    // callers register the buffers every frame. as long as they are the same buffers, the points in them are
+    // the previous interpolated points and velocities can be computed from them.
+    if (vbs && split_count > 0)
+    {
+        bool same = (size_t)split_count == m_dst_buffers.size();
+        for (int spi = 0; same && spi < split_count; ++spi)
+            same = vbs[spi].points == m_dst_buffers[spi].points && vbs[spi].vertex_count == m_dst_buffers[spi].vertex_count;
+        if (!same)
+            m_direct_prev_points.clear();
+        m_dst_buffers.assign(vbs, vbs + split_count);
+    }
+    else
+    {
+        m_dst_buffers.clear();
+        m_direct_prev_points.clear();
+    }
+}
+
+size_t aiPolyMesh::bakeSamples()
+{
+    // the samples are cooked in order. each one gets the velocities relative to the one before it.
+    m_points_prev.clear();
+    size_t ret = super::bakeSamples();
+    // the points of the last sample are not what is shown before the next update
+    m_points_prev.clear();
+    return ret;
+}
+
+void aiPolyMesh::cookSample(Sample& sample)
+{
+    // only regular updates write into the destination buffers. bakeSamples() calls cookSampleBody() directly.
+    m_direct_write = getConfig().direct_write && !m_dst_buffers.empty();
+    super::cookSample(sample);
+    m_direct_write = false;
+}
+
+// interpolates what it can into the registered destination buffers (per split slices of the vertex streams).
+// returns the streams written as Sample::DirectStream flags.
+int aiPolyMesh::interpolateToDestination(Sample& sample)
+{
+    auto& config = getConfig();
+    auto& summary = getSummary();
+    auto& splits = sample.m_topology->m_refiner.splits;
+    size_t num_vertices = (size_t)sample.m_topology->m_vertex_count;
+
+    bool has_points = true, has_velocities = true, has_normals = true;
+    bool has_uv0 = true, has_uv1 = true, has_rgba = true;
+    bool valid = !splits.empty() && m_dst_buffers.size() == splits.size();
+    for (size_t spi = 0; valid && spi < splits.size(); ++spi)
+    {
+        auto& dst = m_dst_buffers[spi];
+        valid = dst.vertex_count == splits[spi].vertex_count;
+        has_points &= dst.points != nullptr;
+        has_velocities &= dst.velocities != nullptr;
+        has_normals &= dst.normals != nullptr;
+        has_uv0 &= dst.uv0 != nullptr;
+        has_uv1 &= dst.uv1 != nullptr;
+        has_rgba &= dst.rgba != nullptr;
+    }
+    if (!valid)
+    {
+        m_direct_prev_points.clear();
+        return 0;
+    }
+
+    int ret = 0;
+    float w = m_current_time_offset;
+
+    // tangents are generated from the contiguous interpolated points and normals. keep them on the regular path.
+    bool direct_points = summary.interpolate_points && has_points &&
+        (!summary.compute_velocities || has_velocities) &&
+        !(summary.compute_tangents && m_constants->tangents.empty()) &&
+        sample.m_points.size() == num_vertices && sample.m_points2.size() == num_vertices;
+    bool direct_normals = direct_points && has_normals &&
+        summary.interpolate_normals && m_constants->normals.empty() &&
+        sample.m_normals.size() == num_vertices && sample.m_normals2.size() == num_vertices;
+
+    if (direct_points)
+    {
+        // previous interpolated points are either still in the destination buffers or in m_points_prev
+        bool prev_in_place = false;
+        if (summary.compute_velocities && m_direct_prev_points.size() == splits.size())
+        {
+            prev_in_place = true;
+            for (size_t spi = 0; spi < splits.size(); ++spi)
+                prev_in_place &= m_direct_prev_points[spi] == m_dst_buffers[spi].points;
+        }
+        bool prev_in_schema = summary.compute_velocities && !prev_in_place && m_points_prev.size() == num_vertices;
+
+        for (size_t spi = 0; spi < splits.size(); ++spi)
+        {
+            auto& dst = m_dst_buffers[spi];
+            auto& split = splits[spi];
+            int offset = split.vertex_offset;
+
+            abcV3 *dst_velocities = nullptr;
+            const abcV3 *prev_points = nullptr;
+            if (summary.compute_velocities)
+            {
+                dst_velocities = dst.velocities;
+                if (prev_in_place)
+                    prev_points = dst.points;
+                else if (prev_in_schema)
+                    prev_points = m_points_prev.data() + offset;
+                else
+                    memset(dst.velocities, 0, sizeof(abcV3) * split.vertex_count);
+            }
+            LerpVertices(dst.points, dst_velocities, direct_normals ? dst.normals : nullptr,
+                sample.m_points.data() + offset, sample.m_points2.data() + offset, prev_points,
+                direct_normals ? sample.m_normals.data() + offset : nullptr,
+                direct_normals ? sample.m_normals2.data() + offset : nullptr,
+                split.vertex_count, w, config.vertex_motion_scale);
+        }
+
+        // m_points_prev doesn't hold the current interpolated points. the key points have the same layout
+        m_points_prev.clear();
+        sample.m_points_ref = sample.m_points;
+        m_direct_prev_points.resize(splits.size());
+        for (size_t spi = 0; spi < splits.size(); ++spi)
+            m_direct_prev_points[spi] = m_dst_buffers[spi].points;
+
+        ret |= Sample::DirectPoints;
+        if (summary.compute_velocities)
+            ret |= Sample::DirectVelocities;
+        if (direct_normals)
+            ret |= Sample::DirectNormals;
+    }
+    else
+    {
+        m_direct_prev_points.clear();
+    }
+
+    if (summary.interpolate_uv0 && has_uv0 && sample.m_uv0.size() == num_vertices && sample.m_uv02.size() == num_vertices)
+    {
+        LerpToSplits(m_dst_buffers, &aiPolyMeshData::uv0, sample.m_uv0, sample.m_uv02, splits, w);
+        ret |= Sample::DirectUV0;
+    }
+    if (summary.interpolate_uv1 && has_uv1 && sample.m_uv1.size() == num_vertices && sample.m_uv12.size() == num_vertices)
+    {
+        LerpToSplits(m_dst_buffers, &aiPolyMeshData::uv1, sample.m_uv1, sample.m_uv12, splits, w);
+        ret |= Sample::DirectUV1;
+    }
+    if (summary.interpolate_rgba && has_rgba && sample.m_rgba.size() == num_vertices && sample.m_rgba2.size() == num_vertices)
+    {
+        LerpToSplits(m_dst_buffers, &aiPolyMeshData::rgba, sample.m_rgba, sample.m_rgba2, splits, w);
+        ret |= Sample::DirectRgba;
+    }
+
+    if (ret)
+        sample.m_direct_buffers = m_dst_buffers;
+    return ret;
+}
+
 void aiPolyMesh::readSampleBody(Sample& sample, uint64_t idx)
 {
     auto ss = aiIndexToSampleSelector(idx);
     auto ss2 = aiIndexToSampleSelector(idx + 1);
 
+    if (m_force_update_local && m_constants_shared)
+    {
+        // the constant data may be used by other contexts. rebuild it on our own copy.
+        m_constants.reset(new aiMeshConstantData());
+        m_constants->topology.reset(new aiMeshTopology());
+        m_constants_shared = false;
+        sample.m_topology = m_constants->topology;
+    }
+
+    bool use_topology_cache = canCacheTopology();
+    if (m_force_update_local || !use_topology_cache)
+        m_topology_cache.clear();
+
+    bool topology_changed = m_varying_topology || m_force_update_local;
+
+    // the topology may be in the topology cache or in other samples. read into a new one instead of clearing it.
+    if (m_varying_topology && sample.m_topology.use_count() > 1)
+        sample.m_topology = std::make_shared<aiMeshTopology>();
+
     auto& topology = *sample.m_topology;
     auto& refiner = topology.m_refiner;
     auto& summary = m_summary;
 
-    bool topology_changed = m_varying_topology || m_force_update_local;
-
     if (topology_changed)
         topology.clear();
 
@@ -543,13 +1197,13 @@ void aiPolyMesh::readSampleBody(Sample& sample, uint64_t idx)
     }
 
     // points
-    if (summary.has_points && m_constant_points.empty())
+    if (summary.has_points && m_constants->points.empty())
     {
         auto param = m_schema.getPositionsProperty();
-        param.get(sample.m_points_sp, ss);
+        readArraySample(param, sample.m_points_sp, sample, Sample::KeyPoints, ss);
         if (summary.interpolate_points)
         {
-            param.get(sample.m_points_sp2, ss2);
+            readArraySample(param, sample.m_points_sp2, sample, Sample::KeyPoints2, ss2);
         }
         else
         {
@@ -561,54 +1215,54 @@ void aiPolyMesh::readSampleBody(Sample& sample, uint64_t idx)
     }
 
     // normals
-    if (m_constant_normals.empty() && summary.has_normals_prop && !summary.compute_normals)
+    if (m_constants->normals.empty() && summary.has_normals_prop && !summary.compute_normals)
     {
         auto param = m_schema.getNormalsParam();
-        param.getIndexed(sample.m_normals_sp, ss);
+        readArraySample(param, sample.m_normals_sp, sample, Sample::KeyNormals, ss);
         if (summary.interpolate_normals)
         {
-            param.getIndexed(sample.m_normals_sp2, ss2);
+            readArraySample(param, sample.m_normals_sp2, sample, Sample::KeyNormals2, ss2);
         }
     }
 
     // uv0
-    if (m_constant_uv0.empty() && summary.has_uv0_prop)
+    if (m_constants->uv0.empty() && summary.has_uv0_prop)
     {
         auto param = m_schema.getUVsParam();
-        param.getIndexed(sample.m_uv0_sp, ss);
+        readArraySample(param, sample.m_uv0_sp, sample, Sample::KeyUV0, ss);
         if (summary.interpolate_uv0)
         {
-            param.getIndexed(sample.m_uv0_sp2, ss2);
+            readArraySample(param, sample.m_uv0_sp2, sample, Sample::KeyUV02, ss2);
         }
     }
 
     // uv1
-    if (m_constant_uv1.empty() && summary.has_uv1_prop)
+    if (m_constants->uv1.empty() && summary.has_uv1_prop)
     {
-        m_uv1_param.getIndexed(sample.m_uv1_sp, ss);
+        readArraySample(m_uv1_param, sample.m_uv1_sp, sample, Sample::KeyUV1, ss);
         if (summary.interpolate_uv1)
         {
-            m_uv1_param.getIndexed(sample.m_uv1_sp2, ss2);
+            readArraySample(m_uv1_param, sample.m_uv1_sp2, sample, Sample::KeyUV12, ss2);
         }
     }
 
     // colors
-    if (m_constant_rgba.empty() && summary.has_rgba_prop)
+    if (m_constants->rgba.empty() && summary.has_rgba_prop)
     {
-        m_rgba_param.getIndexed(sample.m_rgba_sp, ss);
+        readArraySample(m_rgba_param, sample.m_rgba_sp, sample, Sample::KeyRgba, ss);
         if (summary.interpolate_rgba)
         {
-            m_rgba_param.getIndexed(sample.m_rgba_sp2, ss2);
+            readArraySample(m_rgba_param, sample.m_rgba_sp2, sample, Sample::KeyRgba2, ss2);
         }
     }
 
     // rgb
-    if (m_constant_rgb.empty() && summary.has_rgb_prop)
+    if (m_constants->rgb.empty() && summary.has_rgb_prop)
     {
-        m_rgb_param.getIndexed(sample.m_rgb_sp, ss);
+        readArraySample(m_rgb_param, sample.m_rgb_sp, sample, Sample::KeyRgb, ss);
         if (summary.interpolate_rgb)
         {
-            m_rgb_param.getIndexed(sample.m_rgb_sp2, ss2);
+            readArraySample(m_rgb_param, sample.m_rgb_sp2, sample, Sample::KeyRgb2, ss2);
         }
     }
 
@@ -616,21 +1270,115 @@ void aiPolyMesh::readSampleBody(Sample& sample, uint64_t idx)
     if (bounds_param && bounds_param.getNumSamples() > 0)
         bounds_param.get(sample.m_bounds, ss);
 
+    // reuse the refined topology if the same one has been read before
+    if (use_topology_cache)
+    {
+        uint64_t hash = getTopologyHash(sample);
+        auto it = m_topology_cache.find(hash);
+        if (it != m_topology_cache.end())
+        {
+            sample.m_topology = it->second.topology;
+            it->second.last_use = ++m_topology_cache_clock;
+        }
+        else
+        {
+            topology.m_hash = hash;
+        }
+    }
+
+    // the topology was cooked by another context but it is new to this one
+    if (m_constants_shared && m_last_sample_index == -1)
+        topology_changed = true;
+
     sample.m_topology_changed = topology_changed;
 }
 
+bool aiPolyMesh::swapReadData(Sample& dst, Sample& src)
+{
+    std::swap(dst.m_points_sp, src.m_points_sp);
+    std::swap(dst.m_points_sp2, src.m_points_sp2);
+    std::swap(dst.m_velocities_sp, src.m_velocities_sp);
+    std::swap(dst.m_normals_sp, src.m_normals_sp);
+    std::swap(dst.m_normals_sp2, src.m_normals_sp2);
+    std::swap(dst.m_uv0_sp, src.m_uv0_sp);
+    std::swap(dst.m_uv0_sp2, src.m_uv0_sp2);
+    std::swap(dst.m_uv1_sp, src.m_uv1_sp);
+    std::swap(dst.m_uv1_sp2, src.m_uv1_sp2);
+    std::swap(dst.m_rgba_sp, src.m_rgba_sp);
+    std::swap(dst.m_rgba_sp2, src.m_rgba_sp2);
+    std::swap(dst.m_rgb_sp, src.m_rgb_sp);
+    std::swap(dst.m_rgb_sp2, src.m_rgb_sp2);
+    std::swap(dst.m_bounds, src.m_bounds);
+    std::swap(dst.m_read_keys, src.m_read_keys);
+
+    // varying topology: each sample has its own topology and the prefetched one has the new counts & indices.
+    // otherwise the topology is shared and the live sample must keep the current one.
+    if (m_varying_topology)
+        std::swap(dst.m_topology, src.m_topology);
+    std::swap(dst.m_topology_changed, src.m_topology_changed);
+    return true;
+}
+
+void aiPolyMesh::onSampleRestored(Sample& sample, const Sample *prev)
+{
+    // the flag was set relative to the sample read before it. what matters now is the one shown before it.
+    sample.m_topology_changed = !prev || prev->m_topology != sample.m_topology;
+    sample.decompressPoints();
+}
+
+void aiPolyMesh::onSampleStored(Sample& sample)
+{
+    sample.releaseReadData();
+
+    // only deforming meshes with constant topology have the same number of points in all samples
+    if (!getConfig().compress_cached_samples || m_summary.topology_variance != aiTopologyVariance::Homogeneous)
+        return;
+
+    if (!m_key_points)
+    {
+        if (sample.m_points.empty())
+            return;
+        m_key_points = std::make_shared<RawVector<abcV3>>(sample.m_points);
+    }
+    sample.compressPoints(m_key_points);
+}
+
+bool aiPolyMesh::recycleSample(Sample& sample)
+{
+    // the read fetches everything again (releaseReadData() reset the keys) and the cook discards the compressed
+    // points. the remapped buffers are overwritten or, if their cooked keys still match, still valid.
+    // velocities don't depend on the sample (m_points_prev is the schema's).
+    return sample.m_topology != nullptr;
+}
+
 void aiPolyMesh::cookSampleBody(Sample& sample)
 {
     auto& topology = *sample.m_topology;
     auto& refiner = topology.m_refiner;
     auto& config = getConfig();
     auto& summary = getSummary();
+    const abcV3 point_scale = GetTransformScale(config, config.scale_factor);
+    const abcV3 normal_scale = GetTransformScale(config, 1.0f);
+    sample.m_direct_streams = 0;
 
     // interpolation can't work with varying topology
     if (m_varying_topology && !m_sample_index_changed)
         return;
 
+    // a new read. the compressed points (if any) are of the previous index.
+    if (m_sample_index_changed)
+        sample.discardCompressedPoints();
+
+    // shared constant data must not be modified. its topology is already determined.
+    // interpolation-only updates and topologies from the topology cache reuse the remap tables.
     if (sample.m_topology_changed)
+    {
+        // the remapped data was made with other remap tables
+        for (auto& key : sample.m_cooked_keys)
+            key.reset();
+    }
+
+    if (sample.m_topology_changed && m_sample_index_changed && !m_constants_shared && !topology.m_refined)
     {
         onTopologyChange(sample);
     }
@@ -639,74 +1387,78 @@ void aiPolyMesh::cookSampleBody(Sample& sample)
         onTopologyDetermined();
 
         // make remapped vertex buffer
-        if (!m_constant_points.empty())
+        if (!m_constants->points.empty())
         {
-            sample.m_points_ref = m_constant_points;
+            sample.m_points_ref = m_constants->points;
         }
         else
         {
-            Remap(sample.m_points, *sample.m_points_sp, topology.m_remap_points);
-            if (config.swap_handedness)
-                SwapHandedness(sample.m_points.data(), (int)sample.m_points.size());
-            if (config.scale_factor != 1.0f)
-                ApplyScale(sample.m_points.data(), (int)sample.m_points.size(), config.scale_factor);
+            if (needsRemap(sample, Sample::KeyPoints))
+            {
+                RemapTransform(sample.m_points, *sample.m_points_sp, topology.m_remap_points, point_scale);
+            }
             sample.m_points_ref = sample.m_points;
         }
 
-        if (!m_constant_normals.empty())
+        if (!m_constants->normals.empty())
         {
-            sample.m_normals_ref = m_constant_normals;
+            sample.m_normals_ref = m_constants->normals;
         }
         else if (!summary.compute_normals && summary.has_normals_prop)
         {
-            Remap(sample.m_normals, *sample.m_normals_sp.getVals(), topology.m_remap_normals);
-            if (config.swap_handedness)
-                SwapHandedness(sample.m_normals.data(), (int)sample.m_normals.size());
+            if (needsRemap(sample, Sample::KeyNormals))
+            {
+                RemapTransform(sample.m_normals, *sample.m_normals_sp.getVals(), topology.m_remap_normals, normal_scale);
+            }
             sample.m_normals_ref = sample.m_normals;
         }
 
-        if (!m_constant_tangents.empty())
+        if (!m_constants->tangents.empty())
         {
-            sample.m_tangents_ref = m_constant_tangents;
+            sample.m_tangents_ref = m_constants->tangents;
         }
 
-        if (!m_constant_uv0.empty())
+        if (!m_constants->uv0.empty())
         {
-            sample.m_uv0_ref = m_constant_uv0;
+            sample.m_uv0_ref = m_constants->uv0;
         }
         else if (summary.has_uv0_prop)
         {
-            Remap(sample.m_uv0, *sample.m_uv0_sp.getVals(), topology.m_remap_uv0);
+            if (needsRemap(sample, Sample::KeyUV0))
+                Remap(sample.m_uv0, *sample.m_uv0_sp.getVals(), topology.m_remap_uv0);
             sample.m_uv0_ref = sample.m_uv0;
         }
 
-        if (!m_constant_uv1.empty())
+        if (!m_constants->uv1.empty())
         {
-            sample.m_uv1_ref = m_constant_uv1;
+            sample.m_uv1_ref = m_constants->uv1;
         }
         else if (summary.has_uv1_prop)
         {
-            Remap(sample.m_uv1, *sample.m_uv1_sp.getVals(), topology.m_remap_uv1);
+            if (needsRemap(sample, Sample::KeyUV1))
+                Remap(sample.m_uv1, *sample.m_uv1_sp.getVals(), topology.m_remap_uv1);
             sample.m_uv1_ref = sample.m_uv1;
         }
 
-        if (!m_constant_rgba.empty())
+        if (!m_constants->rgba.empty())
         {
-            sample.m_rgba_ref = m_constant_rgba;
+            sample.m_rgba_ref = m_constants->rgba;
         }
         else if (summary.has_rgba_prop)
         {
-            Remap(sample.m_rgba, *sample.m_rgba_sp.getVals(), topology.m_remap_rgba);
+            if (needsRemap(sample, Sample::KeyRgba))
+                Remap(sample.m_rgba, *sample.m_rgba_sp.getVals(), topology.m_remap_rgba);
             sample.m_rgba_ref = sample.m_rgba;
         }
 
-        if (!m_constant_rgb.empty())
+        if (!m_constants->rgb.empty())
         {
-            sample.m_rgb_ref = m_constant_rgb;
+            sample.m_rgb_ref = m_constants->rgb;
         }
         else if (summary.has_rgb_prop)
         {
-            Remap(sample.m_rgb, *sample.m_rgb_sp.getVals(), topology.m_remap_rgb);
+            if (needsRemap(sample, Sample::KeyRgb))
+                Remap(sample.m_rgb, *sample.m_rgb_sp.getVals(), topology.m_remap_rgb);
             sample.m_rgb_ref = sample.m_rgb;
         }
     }
@@ -719,97 +1471,129 @@ void aiPolyMesh::cookSampleBody(Sample& sample)
     {
         // both in the case of topology changed or sample index changed
 
-        if (summary.interpolate_points)
+        if (summary.interpolate_points && needsRemap(sample, Sample::KeyPoints2))
         {
-            Remap(sample.m_points2, *sample.m_points_sp2, topology.m_remap_points);
-            if (config.swap_handedness)
-                SwapHandedness(sample.m_points2.data(), (int)sample.m_points2.size());
-            if (config.scale_factor != 1.0f)
-                ApplyScale(sample.m_points2.data(), (int)sample.m_points2.size(), config.scale_factor);
+            RemapTransform(sample.m_points2, *sample.m_points_sp2, topology.m_remap_points, point_scale);
         }
 
-        if (summary.interpolate_normals)
+        if (summary.interpolate_normals && needsRemap(sample, Sample::KeyNormals2))
         {
-            Remap(sample.m_normals2, *sample.m_normals_sp2.getVals(), topology.m_remap_normals);
-            if (config.swap_handedness)
-                SwapHandedness(sample.m_normals2.data(), (int)sample.m_normals2.size());
+            RemapTransform(sample.m_normals2, *sample.m_normals_sp2.getVals(), topology.m_remap_normals, normal_scale);
         }
 
-        if (summary.interpolate_uv0)
+        if (summary.interpolate_uv0 && needsRemap(sample, Sample::KeyUV02))
         {
             Remap(sample.m_uv02, *sample.m_uv0_sp2.getVals(), topology.m_remap_uv0);
         }
 
-        if (summary.interpolate_uv1)
+        if (summary.interpolate_uv1 && needsRemap(sample, Sample::KeyUV12))
         {
             Remap(sample.m_uv12, *sample.m_uv1_sp2.getVals(), topology.m_remap_uv1);
         }
 
-        if (summary.interpolate_rgba)
+        if (summary.interpolate_rgba && needsRemap(sample, Sample::KeyRgba2))
         {
             Remap(sample.m_rgba2, *sample.m_rgba_sp2.getVals(), topology.m_remap_rgba);
         }
 
-        if (summary.interpolate_rgb)
+        if (summary.interpolate_rgb && needsRemap(sample, Sample::KeyRgb2))
         {
             Remap(sample.m_rgb2, *sample.m_rgb_sp2.getVals(), topology.m_remap_rgb);
         }
 
-        if (!m_constant_velocities.empty())
+        if (!m_constants->velocities.empty())
         {
-            sample.m_velocities_ref = m_constant_velocities;
+            sample.m_velocities_ref = m_constants->velocities;
         }
         else if (!summary.compute_velocities && summary.has_velocities_prop)
         {
-            auto& dst = summary.constant_velocities ? m_constant_velocities : sample.m_velocities;
-            Remap(dst, *sample.m_velocities_sp, topology.m_remap_points);
-            if (config.swap_handedness)
-                SwapHandedness(dst.data(), (int)dst.size());
-            if (config.scale_factor != 1.0f)
-                ApplyScale(dst.data(), (int)dst.size(), config.scale_factor);
+            auto& dst = summary.constant_velocities ? m_constants->velocities : sample.m_velocities;
+            RemapTransform(dst, *sample.m_velocities_sp, topology.m_remap_points, point_scale);
             sample.m_velocities_ref = dst;
         }
     }
 
     // interpolate or compute data
 
+    // with destination buffers registered, interpolated streams are written straight into them
+    if (m_direct_write)
+        sample.m_direct_streams = interpolateToDestination(sample);
+    int direct = sample.m_direct_streams;
+
     // points
-    if (summary.interpolate_points)
+    bool normals_lerped = false;
+    if (summary.interpolate_points && !(direct & Sample::DirectPoints))
     {
-        if (summary.compute_velocities)
-            sample.m_points_int.swap(sample.m_points_prev);
-
-        Lerp(sample.m_points_int, sample.m_points, sample.m_points2, m_current_time_offset);
-        sample.m_points_ref = sample.m_points_int;
-
-        if (summary.compute_velocities)
+        if (sample.m_points.size() != sample.m_points2.size())
+        {
+            DebugError("something is wrong!!");
+        }
+        else
         {
-            sample.m_velocities.resize_discard(sample.m_points.size());
-            if (sample.m_points_int.size() == sample.m_points_prev.size())
+            int num_points = (int)sample.m_points.size();
+            sample.m_points_int.resize_discard(num_points);
+
+            // previous interpolated points are not available on the first frame or after topology changes
+            abcV3 *dst_velocities = nullptr;
+            const abcV3 *prev_points = nullptr;
+            if (summary.compute_velocities)
             {
-                GenerateVelocities(sample.m_velocities.data(), sample.m_points_int.data(), sample.m_points_prev.data(),
-                    (int)sample.m_points_int.size(), config.vertex_motion_scale);
+                sample.m_velocities.resize_discard(num_points);
+                if ((int)m_points_prev.size() == num_points)
+                {
+                    dst_velocities = sample.m_velocities.data();
+                    prev_points = m_points_prev.data();
+                }
+                else
+                {
+                    sample.m_velocities.zeroclear();
+                }
+                sample.m_velocities_ref = sample.m_velocities;
             }
-            else
+
+            // interpolate normals in the same pass if they line up with points
+            abcV3 *dst_normals = nullptr;
+            if (m_constants->normals.empty() && summary.interpolate_normals &&
+                (int)sample.m_normals.size() == num_points && (int)sample.m_normals2.size() == num_points)
             {
-                sample.m_velocities.zeroclear();
+                sample.m_normals_int.resize_discard(num_points);
+                dst_normals = sample.m_normals_int.data();
+                normals_lerped = true;
             }
-            sample.m_velocities_ref = sample.m_velocities;
+
+            LerpVertices(sample.m_points_int.data(), dst_velocities, dst_normals,
+                sample.m_points.data(), sample.m_points2.data(), prev_points,
+                sample.m_normals.data(), sample.m_normals2.data(),
+                num_points, m_current_time_offset, config.vertex_motion_scale);
+
+            // the next cook may be of another sample (sample cache, baked samples). keep the interpolated points on
+            // the schema. the swap moves the buffer, so m_points_ref below stays valid until then.
+            if (summary.compute_velocities)
+                sample.m_points_int.swap(m_points_prev);
         }
+        sample.m_points_ref = summary.compute_velocities ? m_points_prev : sample.m_points_int;
     }
 
     // normals
-    if (!m_constant_normals.empty())
+    if (!m_constants->normals.empty())
     {
         // do nothing
     }
+    else if (direct & Sample::DirectNormals)
+    {
+        // written to the destination buffers
+    }
+    else if (normals_lerped)
+    {
+        sample.m_normals_ref = sample.m_normals_int;
+    }
     else if (summary.interpolate_normals)
     {
         Lerp(sample.m_normals_int, sample.m_normals, sample.m_normals2, (float)m_current_time_offset);
         Normalize(sample.m_normals_int.data(), (int)sample.m_normals.size());
         sample.m_normals_ref = sample.m_normals_int;
     }
-    else if (summary.compute_normals && (m_sample_index_changed || summary.interpolate_points))
+    else if (summary.compute_normals && m_sample_index_changed)
     {
         if (sample.m_points_ref.empty())
         {
@@ -820,15 +1604,19 @@ void aiPolyMesh::cookSampleBody(Sample& sample)
         {
             const auto &indices = topology.m_refiner.new_indices_tri;
             sample.m_normals.resize_discard(sample.m_points_ref.size());
-            GeneratePointNormals(topology.m_counts_sp->get(), topology.m_indices_sp->get(), sample.m_points_sp->get(),
-                    sample.m_normals.data(), topology.m_remap_points.data(), topology.m_counts_sp->size(),
-                    topology.m_remap_points.size(), sample.m_points_sp->size());
+            GenerateNormals(sample.m_normals.data(), m_normals_generator, topology, (const abcV3*)sample.m_points_sp->get(), config);
             sample.m_normals_ref = sample.m_normals;
         }
     }
+    else if (summary.compute_normals && !sample.m_normals.empty())
+    {
+        // computed normals are generated from the key points (m_points_sp), not the interpolated ones. they stay valid
+        // while only the interpolation is redone, also for cached and baked samples that no longer have m_points_sp.
+        sample.m_normals_ref = sample.m_normals;
+    }
 
     // tangents
-    if (!m_constant_tangents.empty())
+    if (!m_constants->tangents.empty())
     {
         // do nothing
     }
@@ -841,30 +1629,29 @@ void aiPolyMesh::cookSampleBody(Sample& sample)
         }
         else
         {
-            const auto &indices = topology.m_refiner.new_indices_tri;
             sample.m_tangents.resize_discard(sample.m_points_ref.size());
-            GenerateTangents(sample.m_tangents.data(), sample.m_points_ref.data(), sample.m_uv0_ref.data(), sample.m_normals_ref.data(),
-                indices.data(), (int)sample.m_points_ref.size(), (int)indices.size() / 3);
+            GenerateVertexTangents(sample.m_tangents.data(), m_tangents_generator, topology, sample.m_points_ref.data(), sample.m_uv0_ref.data(),
+                sample.m_normals_ref.data(), (int)sample.m_points_ref.size(), config);
             sample.m_tangents_ref = sample.m_tangents;
         }
     }
 
     // uv0
-    if (summary.interpolate_uv0)
+    if (summary.interpolate_uv0 && !(direct & Sample::DirectUV0))
     {
         Lerp(sample.m_uv0_int, sample.m_uv0, sample.m_uv02, m_current_time_offset);
         sample.m_uv0_ref = sample.m_uv0_int;
     }
 
     // uv1
-    if (summary.interpolate_uv1)
+    if (summary.interpolate_uv1 && !(direct & Sample::DirectUV1))
     {
         Lerp(sample.m_uv1_int, sample.m_uv1, sample.m_uv12, m_current_time_offset);
         sample.m_uv1_ref = sample.m_uv1_int;
     }
 
     // colors
-    if (summary.interpolate_rgba)
+    if (summary.interpolate_rgba && !(direct & Sample::DirectRgba))
     {
         Lerp(sample.m_rgba_int, sample.m_rgba, sample.m_rgba2, m_current_time_offset);
         sample.m_rgba_ref = sample.m_rgba_int;
@@ -876,6 +1663,41 @@ void aiPolyMesh::cookSampleBody(Sample& sample)
         Lerp(sample.m_rgb_int, sample.m_rgb, sample.m_rgb2, m_current_time_offset);
         sample.m_rgb_ref = sample.m_rgb_int;
     }
+
+    // expand rgb to rgba here so that filling vertex buffers is a plain copy
+    if (!m_constants->rgb.empty())
+    {
+        // the constant data must not be modified once it is shared
+        auto& rgb4 = m_constants->rgb4;
+        if (!m_constants_shared && (sample.m_topology_changed || rgb4.size() != m_constants->rgb.size()))
+        {
+            rgb4.resize_discard(m_constants->rgb.size());
+            RGBToRGBA(rgb4.data(), m_constants->rgb.data(), (int)rgb4.size());
+        }
+        sample.m_rgb4_ref = rgb4;
+    }
+    else if (!sample.m_rgb_ref.empty())
+    {
+        if (sample.m_topology_changed || m_sample_index_changed || summary.interpolate_rgb ||
+            sample.m_rgb4.size() != sample.m_rgb_ref.size())
+        {
+            sample.m_rgb4.resize_discard(sample.m_rgb_ref.size());
+            RGBToRGBA(sample.m_rgb4.data(), sample.m_rgb_ref.data(), (int)sample.m_rgb4.size());
+        }
+        sample.m_rgb4_ref = sample.m_rgb4;
+    }
+    else
+    {
+        sample.m_rgb4_ref.reset();
+    }
+
+    // publish the constant data to the other contexts that load the same archive
+    auto archive = getContext()->getSharedArchive();
+    if (archive && sample.m_topology_changed && !m_varying_topology && !m_constants_shared)
+    {
+        archive->addConstantData(getConstantDataKey(), m_constants);
+        m_constants_shared = true;
+    }
 }
 
 void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
@@ -897,6 +1719,7 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
     refiner.counts = { topology.m_counts_sp->get(), topology.m_counts_sp->size() };
     refiner.indices = { topology.m_indices_sp->get(), topology.m_indices_sp->size() };
     refiner.points = { (float3*)sample.m_points_sp->get(), sample.m_points_sp->size() };
+    topology.m_face_table.build(refiner.counts);
 
     bool has_valid_normals = false;
     bool has_valid_uv0 = false;
@@ -904,24 +1727,33 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
     bool has_valid_rgba = false;
     bool has_valid_rgb = false;
 
+    RawVector<abcV3> corner_normals; // for hard edges of computed normals
+    RawVector<int> corner_groups;
+    int num_normal_groups = 0;
+    MeshRefiner::Attribute<abcV3> attr_normals;
+    MeshRefiner::Attribute<abcV2> attr_uv0;
+    MeshRefiner::Attribute<abcV2> attr_uv1;
+    MeshRefiner::Attribute<abcC4> attr_rgba;
+    MeshRefiner::Attribute<abcC3> attr_rgb;
+
     if (sample.m_normals_sp.valid() && !summary.compute_normals)
     {
         IArray<abcV3> src{ sample.m_normals_sp.getVals()->get(), sample.m_normals_sp.getVals()->size() };
-        auto& dst = summary.constant_normals ? m_constant_normals : sample.m_normals;
+        auto& dst = summary.constant_normals ? m_constants->normals : sample.m_normals;
 
         has_valid_normals = true;
         if (sample.m_normals_sp.isIndexed() && sample.m_normals_sp.getIndices()->size() == refiner.indices.size())
         {
             IArray<int> indices{ (int*)sample.m_normals_sp.getIndices()->get(), sample.m_normals_sp.getIndices()->size() };
-            refiner.addIndexedAttribute<abcV3>(src, indices, dst, topology.m_remap_normals);
+            attr_normals.setIndexed(src, indices, dst, topology.m_remap_normals);
         }
         else if (src.size() == refiner.indices.size())
         {
-            refiner.addExpandedAttribute<abcV3>(src, dst, topology.m_remap_normals);
+            attr_normals.setExpanded(src, dst, topology.m_remap_normals);
         }
         else if (src.size() == refiner.points.size())
         {
-            refiner.addIndexedAttribute<abcV3>(src, refiner.indices, dst, topology.m_remap_normals);
+            attr_normals.setIndexed(src, refiner.indices, dst, topology.m_remap_normals);
         }
         else
         {
@@ -929,25 +1761,37 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
             has_valid_normals = false;
         }
     }
+    else if (summary.compute_normals && PointNormalsGenerator::splitsHardEdges(config.smoothing_angle))
+    {
+        // hard edges split vertices. which edges are hard is decided by the points of this sample and kept as long as
+        // the topology is. the corners that get the same normal here form a normal group (see GenerateNormals()).
+        auto& dst = summary.constant_normals ? m_constants->normals : sample.m_normals;
+        refiner.connection.buildConnection(refiner.indices, refiner.counts, refiner.points);
+        m_normals_generator.generateCorners(corner_normals, topology.m_face_table, refiner.indices,
+            (const abcV3*)sample.m_points_sp->get(), refiner.connection,
+            config.normals_weighting == NormalsWeighting::Angle, config.smoothing_angle);
+        attr_normals.setExpanded(corner_normals, dst, topology.m_remap_normals);
+        num_normal_groups = GroupCornersByNormal(corner_groups, corner_normals, refiner.connection);
+    }
 
     if (sample.m_uv0_sp.valid())
     {
         IArray<abcV2> src{ sample.m_uv0_sp.getVals()->get(), sample.m_uv0_sp.getVals()->size() };
-        auto& dst = summary.constant_uv0 ? m_constant_uv0 : sample.m_uv0;
+        auto& dst = summary.constant_uv0 ? m_constants->uv0 : sample.m_uv0;
 
         has_valid_uv0 = true;
         if (sample.m_uv0_sp.isIndexed() && sample.m_uv0_sp.getIndices()->size() == refiner.indices.size())
         {
             IArray<int> indices{ (int*)sample.m_uv0_sp.getIndices()->get(), sample.m_uv0_sp.getIndices()->size() };
-            refiner.addIndexedAttribute<abcV2>(src, indices, dst, topology.m_remap_uv0);
+            attr_uv0.setIndexed(src, indices, dst, topology.m_remap_uv0);
         }
         else if (src.size() == refiner.indices.size())
         {
-            refiner.addExpandedAttribute<abcV2>(src, dst, topology.m_remap_uv0);
+            attr_uv0.setExpanded(src, dst, topology.m_remap_uv0);
         }
         else if (src.size() == refiner.points.size())
         {
-            refiner.addIndexedAttribute<abcV2>(src, refiner.indices, dst, topology.m_remap_uv0);
+            attr_uv0.setIndexed(src, refiner.indices, dst, topology.m_remap_uv0);
         }
         else
         {
@@ -959,21 +1803,21 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
     if (sample.m_uv1_sp.valid())
     {
         IArray<abcV2> src{ sample.m_uv1_sp.getVals()->get(), sample.m_uv1_sp.getVals()->size() };
-        auto& dst = summary.constant_uv1 ? m_constant_uv1 : sample.m_uv1;
+        auto& dst = summary.constant_uv1 ? m_constants->uv1 : sample.m_uv1;
 
         has_valid_uv1 = true;
         if (sample.m_uv1_sp.isIndexed() && sample.m_uv1_sp.getIndices()->size() == refiner.indices.size())
         {
             IArray<int> uv1_indices{ (int*)sample.m_uv1_sp.getIndices()->get(), sample.m_uv1_sp.getIndices()->size() };
-            refiner.addIndexedAttribute<abcV2>(src, uv1_indices, dst, topology.m_remap_uv1);
+            attr_uv1.setIndexed(src, uv1_indices, dst, topology.m_remap_uv1);
         }
         else if (src.size() == refiner.indices.size())
         {
-            refiner.addExpandedAttribute<abcV2>(src, dst, topology.m_remap_uv1);
+            attr_uv1.setExpanded(src, dst, topology.m_remap_uv1);
         }
         else if (src.size() == refiner.points.size())
         {
-            refiner.addIndexedAttribute<abcV2>(src, refiner.indices, dst, topology.m_remap_uv1);
+            attr_uv1.setIndexed(src, refiner.indices, dst, topology.m_remap_uv1);
         }
         else
         {
@@ -985,21 +1829,21 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
     if (sample.m_rgba_sp.valid())
     {
         IArray<abcC4> src{ sample.m_rgba_sp.getVals()->get(), sample.m_rgba_sp.getVals()->size() };
-        auto& dst = summary.constant_rgba ? m_constant_rgba : sample.m_rgba;
+        auto& dst = summary.constant_rgba ? m_constants->rgba : sample.m_rgba;
 
         has_valid_rgba = true;
         if (sample.m_rgba_sp.isIndexed() && sample.m_rgba_sp.getIndices()->size() == refiner.indices.size())
         {
             IArray<int> colors_indices{ (int*)sample.m_rgba_sp.getIndices()->get(), sample.m_rgba_sp.getIndices()->size() };
-            refiner.addIndexedAttribute<abcC4>(src, colors_indices, dst, topology.m_remap_rgba);
+            attr_rgba.setIndexed(src, colors_indices, dst, topology.m_remap_rgba);
         }
         else if (src.size() == refiner.indices.size())
         {
-            refiner.addExpandedAttribute<abcC4>(src, dst, topology.m_remap_rgba);
+            attr_rgba.setExpanded(src, dst, topology.m_remap_rgba);
         }
         else if (src.size() == refiner.points.size())
         {
-            refiner.addIndexedAttribute<abcC4>(src, refiner.indices, dst, topology.m_remap_rgba);
+            attr_rgba.setIndexed(src, refiner.indices, dst, topology.m_remap_rgba);
         }
         else
         {
@@ -1011,21 +1855,21 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
     if (sample.m_rgb_sp.valid())
     {
         IArray<abcC3> src{ sample.m_rgb_sp.getVals()->get(), sample.m_rgb_sp.getVals()->size() };
-        auto& dst = summary.constant_rgb ? m_constant_rgb : sample.m_rgb;
+        auto& dst = summary.constant_rgb ? m_constants->rgb : sample.m_rgb;
 
         has_valid_rgb = true;
         if (sample.m_rgb_sp.isIndexed() && sample.m_rgb_sp.getIndices()->size() == refiner.indices.size())
         {
             IArray<int> rgb_indices{ (int*)sample.m_rgb_sp.getIndices()->get(), sample.m_rgb_sp.getIndices()->size() };
-            refiner.addIndexedAttribute<abcC3>(src, rgb_indices, dst, topology.m_remap_rgb);
+            attr_rgb.setIndexed(src, rgb_indices, dst, topology.m_remap_rgb);
         }
         else if (src.size() == refiner.indices.size())
         {
-            refiner.addExpandedAttribute<abcC3>(src, dst, topology.m_remap_rgb);
+            attr_rgb.setExpanded(src, dst, topology.m_remap_rgb);
         }
         else if (src.size() == refiner.points.size())
         {
-            refiner.addIndexedAttribute<abcC3>(src, refiner.indices, dst, topology.m_remap_rgb);
+            attr_rgb.setIndexed(src, refiner.indices, dst, topology.m_remap_rgb);
         }
         else
         {
@@ -1034,8 +1878,7 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
         }
     }
 
-
-    refiner.refine();
+    refiner.refine(attr_normals, attr_uv0, attr_uv1, attr_rgba, attr_rgb);
     refiner.retopology(config.swap_face_winding);
 
     // generate submeshes
@@ -1068,20 +1911,30 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
     topology.m_vertex_count = (int)refiner.new_points.size();
     onTopologyDetermined();
 
+    if (!corner_groups.empty())
+    {
+        topology.m_normal_groups.buildConnection(corner_groups, refiner.counts, { (const float3*)nullptr, (size_t)num_normal_groups });
+        auto& remap = topology.m_remap_normals;
+        topology.m_remap_normal_groups.resize_discard(remap.size());
+        for (size_t vi = 0; vi < remap.size(); ++vi)
+            topology.m_remap_normal_groups[vi] = corner_groups[remap[vi]];
+    }
+
+    if (summary.compute_tangents && config.tangents_mode == TangentsMode::MikkTSpace)
+        MikkTangentsGenerator::buildConnection(topology.m_tangents_connection, refiner.new_indices_tri, topology.m_vertex_count);
+
     topology.m_remap_points.swap(refiner.new2old_points);
     {
-        auto& points = summary.constant_points ? m_constant_points : sample.m_points;
+        auto& points = summary.constant_points ? m_constants->points : sample.m_points;
         points.swap((RawVector<abcV3>&)refiner.new_points);
-        if (config.swap_handedness)
-            SwapHandedness(points.data(), (int)points.size());
-        if (config.scale_factor != 1.0f)
-            ApplyScale(points.data(), (int)points.size(), config.scale_factor);
+        if (config.swap_handedness || config.scale_factor != 1.0f)
+            RemapTransform(points.data(), points.data(), nullptr, (int)points.size(), GetTransformScale(config, config.scale_factor));
         sample.m_points_ref = points;
     }
 
     if (has_valid_normals)
     {
-        sample.m_normals_ref = !m_constant_normals.empty() ? m_constant_normals : sample.m_normals;
+        sample.m_normals_ref = !m_constants->normals.empty() ? m_constants->normals : sample.m_normals;
         if (config.swap_handedness)
             SwapHandedness(sample.m_normals_ref.data(), (int)sample.m_normals_ref.size());
     }
@@ -1091,43 +1944,44 @@ void aiPolyMesh::onTopologyChange(aiPolyMeshSample & sample)
     }
 
     if (has_valid_uv0)
-        sample.m_uv0_ref = !m_constant_uv0.empty() ? m_constant_uv0 : sample.m_uv0;
+        sample.m_uv0_ref = !m_constants->uv0.empty() ? m_constants->uv0 : sample.m_uv0;
     else
         sample.m_uv0_ref.reset();
 
     if (has_valid_uv1)
-        sample.m_uv1_ref = !m_constant_uv1.empty() ? m_constant_uv1 : sample.m_uv1;
+        sample.m_uv1_ref = !m_constants->uv1.empty() ? m_constants->uv1 : sample.m_uv1;
     else
         sample.m_uv1_ref.reset();
 
     if (has_valid_rgba)
-        sample.m_rgba_ref = !m_constant_rgba.empty() ? m_constant_rgba : sample.m_rgba;
+        sample.m_rgba_ref = !m_constants->rgba.empty() ? m_constants->rgba : sample.m_rgba;
     else
         sample.m_rgba_ref.reset();
 
     if (has_valid_rgb)
-        sample.m_rgb_ref = !m_constant_rgb.empty() ? m_constant_rgb : sample.m_rgb;
+        sample.m_rgb_ref = !m_constants->rgb.empty() ? m_constants->rgb : sample.m_rgb;
     else
         sample.m_rgb_ref.reset();
 
     if (summary.constant_normals && summary.compute_normals)
     {
         const auto &indices = topology.m_refiner.new_indices_tri;
-        m_constant_normals.resize_discard(m_constant_points.size());
-        GeneratePointNormals(topology.m_counts_sp->get(), topology.m_indices_sp->get(), sample.m_points_sp->get(),
-                m_constant_normals.data(), topology.m_remap_points.data(), topology.m_counts_sp->size(),
-                topology.m_remap_points.size(), sample.m_points_sp->size());
-        sample.m_normals_ref = m_constant_normals;
+        m_constants->normals.resize_discard(m_constants->points.size());
+        GenerateNormals(m_constants->normals.data(), m_normals_generator, topology, (const abcV3*)sample.m_points_sp->get(), config);
+        sample.m_normals_ref = m_constants->normals;
     }
     if (summary.constant_tangents && summary.compute_tangents)
     {
-        const auto &indices = topology.m_refiner.new_indices_tri;
-        m_constant_tangents.resize_discard(m_constant_points.size());
-        GenerateTangents(m_constant_tangents.data(), m_constant_points.data(), m_constant_uv0.data(), m_constant_normals.data(),
-            indices.data(), (int)m_constant_points.size(), (int)indices.size() / 3);
-        sample.m_tangents_ref = m_constant_tangents;
+        m_constants->tangents.resize_discard(m_constants->points.size());
+        GenerateVertexTangents(m_constants->tangents.data(), m_tangents_generator, topology, m_constants->points.data(), m_constants->uv0.data(),
+            m_constants->normals.data(), (int)m_constants->points.size(), config);
+        sample.m_tangents_ref = m_constants->tangents;
     }
 
+    topology.m_refined = true;
+    if (canCacheTopology())
+        storeTopologyToCache(sample.m_topology);
+
     // velocities are done in later part of cookSampleBody()
 }
 
@@ -52,12 +52,53 @@ public:
     RawVector<int> m_remap_rgba;
     RawVector<int> m_remap_rgb;
 
+    MeshFaceTable m_face_table; // face offsets and fan triangles of the source indices. built in aiPolyMesh::onTopologyChange()
+    // computed normals with hard edges: the corners of each point that had the same normal when the edges were chosen
+    // form a group. per frame, every group gets the smooth normal of its corners and vertices take their group's.
+    MeshConnectionInfo m_normal_groups;
+    RawVector<int> m_remap_normal_groups;
+    MeshConnectionInfo m_tangents_connection; // vertex to triangle corners. built in aiPolyMesh::onTopologyChange() with TangentsMode::MikkTSpace
+
     int m_vertex_count = 0;
     int m_index_count = 0; // triangulated
+
+    uint64_t m_hash = 0; // content hash of what the refinement depends on. only for the topology cache
+    bool m_refined = false; // set by aiPolyMesh::onTopologyChange(). must not be modified after that if cached
 };
 using TopologyPtr = std::shared_ptr<aiMeshTopology>;
 
 
+// digest of an array sample stored in the archive. invalid if the archive doesn't provide it.
+struct aiSampleKey
+{
+    AbcCoreAbstract::ArraySampleKey values;
+    AbcCoreAbstract::ArraySampleKey indices; // for indexed geom params
+    bool valid = false;
+
+    bool matches(const aiSampleKey& v) const { return valid && v.valid && values == v.values && indices == v.indices; }
+    void reset() { valid = false; }
+};
+
+
+// cooked data that doesn't vary over time.
+// with aiConfig::share_archives, it is shared by the meshes of contexts that load the same archive.
+struct aiMeshConstantData
+{
+    TopologyPtr topology; // shared topology when the mesh's topology is not varying
+
+    RawVector<abcV3> points;
+    RawVector<abcV3> velocities;
+    RawVector<abcV3> normals;
+    RawVector<abcV4> tangents;
+    RawVector<abcV2> uv0;
+    RawVector<abcV2> uv1;
+    RawVector<abcC4> rgba;
+    RawVector<abcC3> rgb;
+    RawVector<abcC4> rgb4; // rgb expanded to rgba
+};
+using ConstantDataPtr = std::shared_ptr<aiMeshConstantData>;
+
+
 class aiPolyMeshSample : public aiSample
 {
     using super = aiSample;
@@ -66,15 +107,48 @@ public:
     aiPolyMeshSample(aiPolyMesh *schema, TopologyPtr topo);
     ~aiPolyMeshSample();
     void reset();
+    size_t getMemoryUsage() const override;
 
     void getSummary(aiMeshSampleSummary &dst) const;
     void getSplitSummaries(aiMeshSplitSummary  *dst) const;
     void getSubmeshSummaries(aiSubmeshSummary *dst) const;
 
+    // vertex streams of a split. fillVertexBuffer() runs them as separate tasks
+    enum FillStream
+    {
+        FillPoints, // + bounds
+        FillVelocities,
+        FillNormals,
+        FillTangents,
+        FillUV0,
+        FillUV1,
+        FillRgba,
+        FillRgb,
+        FillStreamCount
+    };
+    static const int fill_parallel_threshold = 0x10000; // in vertices
+
     void fillSplitVertices(int split_index, aiPolyMeshData &data) const;
+    void fillSplitStream(int split_index, int stream, aiPolyMeshData &data) const;
     void fillSubmeshIndices(int submesh_index, aiSubmeshData &data) const;
     void fillVertexBuffer(aiPolyMeshData* vbs, aiSubmeshData* ibs);
 
+    // while the sample is cached or baked, m_points and m_points2 can be kept as 16 bit quantized deltas
+    // against a key frame (aiConfig::compress_cached_samples). data derived from them is released.
+    struct QuantizedPoints
+    {
+        RawVector<uint16_t> data;
+        abcV3 offset, step;
+    };
+    using KeyPointsPtr = std::shared_ptr<const RawVector<abcV3>>;
+    bool compressPoints(const KeyPointsPtr& key);
+    void decompressPoints();
+    void discardCompressedPoints();
+
+    // cached and baked samples are only cooked again for interpolation, which works on the remapped data.
+    // drops the array samples of the read.
+    void releaseReadData();
+
 public:
     Abc::P3fArraySamplePtr m_points_sp, m_points_sp2;
     Abc::V3fArraySamplePtr m_velocities_sp;
@@ -92,8 +166,9 @@ public:
     IArray<abcV4> m_tangents_ref;
     IArray<abcC4> m_rgba_ref;
     IArray<abcC3> m_rgb_ref;
+    IArray<abcC4> m_rgb4_ref; // m_rgb_ref expanded to rgba at cook time. what fillVertexBuffer() copies
 
-    RawVector<abcV3> m_points, m_points2, m_points_int, m_points_prev;
+    RawVector<abcV3> m_points, m_points2, m_points_int;
     RawVector<abcV3> m_velocities;
     RawVector<abcV2> m_uv0, m_uv02, m_uv0_int;
     RawVector<abcV2> m_uv1, m_uv12, m_uv1_int;
@@ -101,10 +176,44 @@ public:
     RawVector<abcV4> m_tangents;
     RawVector<abcC4> m_rgba, m_rgba2, m_rgba_int;
     RawVector<abcC3> m_rgb, m_rgb2, m_rgb_int;
+    RawVector<abcC4> m_rgb4;
 
     TopologyPtr m_topology;
     bool m_topology_changed = false;
 
+    // keys of the array samples in *_sp (read) and of the ones m_points, m_points2, ... are remapped from (cooked).
+    // with aiConfig::skip_unchanged_attributes, the fetch / the remap is skipped when they match.
+    enum KeySlot
+    {
+        KeyPoints, KeyPoints2,
+        KeyNormals, KeyNormals2,
+        KeyUV0, KeyUV02,
+        KeyUV1, KeyUV12,
+        KeyRgba, KeyRgba2,
+        KeyRgb, KeyRgb2,
+        KeySlotCount
+    };
+    aiSampleKey m_read_keys[KeySlotCount];
+    aiSampleKey m_cooked_keys[KeySlotCount];
+
+    // streams the last cook interpolated straight into the destination buffers (see aiPolyMesh::setDestinationBuffers()).
+    // fillSplitVertices() doesn't copy them again.
+    enum DirectStream
+    {
+        DirectPoints = 1 << 0,
+        DirectVelocities = 1 << 1,
+        DirectNormals = 1 << 2,
+        DirectUV0 = 1 << 3,
+        DirectUV1 = 1 << 4,
+        DirectRgba = 1 << 5,
+    };
+    int m_direct_streams = 0;
+    std::vector<aiPolyMeshData> m_direct_buffers;
+
+    KeyPointsPtr m_key_points;
+    QuantizedPoints m_points_q, m_points2_q;
+    bool m_points_compressed = false;
+
     std::future<void> m_async_copy;
 };
 
@@ -127,27 +236,65 @@ public:
     Sample* newSample() override;
     void readSampleBody(Sample& sample, uint64_t idx) override;
     void cookSampleBody(Sample& sample) override;
+    bool swapReadData(Sample& dst, Sample& src) override;
+    void onSampleRestored(Sample& sample, const Sample *prev) override;
+    void onSampleStored(Sample& sample) override;
+    bool recycleSample(Sample& sample) override;
+    void cookSample(Sample& sample) override;
+    size_t bakeSamples() override;
 
     void onTopologyChange(aiPolyMeshSample& sample);
     void onTopologyDetermined();
+    void getSkipStats(aiMeshSkipStats& dst) const;
+    void setDestinationBuffers(const aiPolyMeshData *vbs, int split_count);
 
 public:
-    RawVector<abcV3> m_constant_points;
-    RawVector<abcV3> m_constant_velocities;
-    RawVector<abcV3> m_constant_normals;
-    RawVector<abcV4> m_constant_tangents;
-    RawVector<abcV2> m_constant_uv0;
-    RawVector<abcV2> m_constant_uv1;
-    RawVector<abcC4> m_constant_rgba;
-    RawVector<abcC3> m_constant_rgb;
+    ConstantDataPtr m_constants;
+
+protected:
+    void setupBody() override;
 
 private:
+    std::string getConstantDataKey() const;
+    bool isTopologyActuallyConstant();
+    template<class Property, class ArraySample>
+    void readArraySample(Property& prop, ArraySample& dst, Sample& sample, int slot, const abcSampleSelector& ss);
+    bool needsRemap(Sample& sample, int slot);
+    uint64_t getTopologyHash(const Sample& sample) const;
+    bool canCacheTopology() const;
+    void storeTopologyToCache(const TopologyPtr& topology);
+    int interpolateToDestination(Sample& sample);
+
     aiMeshSummaryInternal m_summary;
     AbcGeom::IV2fGeomParam m_uv1_param;
     AbcGeom::IC4fGeomParam m_rgba_param;
     AbcGeom::IC3fGeomParam m_rgb_param;
 
-    TopologyPtr m_shared_topology;
     abcFaceSetSchemas m_facesets;
+    aiPolyMeshSample::KeyPointsPtr m_key_points;
+
+    // refined topologies of varying topology meshes by hash (aiConfig::topology_cache_size)
+    struct CachedTopology
+    {
+        TopologyPtr topology;
+        uint64_t last_use = 0;
+    };
+    std::map<uint64_t, CachedTopology> m_topology_cache;
+    uint64_t m_topology_cache_clock = 0;
+
+    // skipped fetches / remaps per attribute (points, normals, uv0, uv1, rgba, rgb). reads may run on the prefetch task
+    std::atomic<int64_t> m_read_skips[aiPolyMeshSample::KeySlotCount / 2];
+    std::atomic<int64_t> m_remap_skips[aiPolyMeshSample::KeySlotCount / 2];
+    // per split vertex buffers registered by the caller before updates. the interpolation stage writes into them
+    std::vector<aiPolyMeshData> m_dst_buffers;
+    // scratch of computed normals and tangents. per schema: the topology (and the face table and connection it reads) may be
+    // shared with other contexts that update in parallel
+    PointNormalsGenerator m_normals_generator;
+    MikkTangentsGenerator m_tangents_generator;
+    std::vector<abcV3*> m_direct_prev_points; // destination points that hold the previous interpolated points
+    RawVector<abcV3> m_points_prev; // previous interpolated points, whichever sample they were cooked with
+    bool m_direct_write = false;
+
     bool m_varying_topology = false;
+    bool m_constants_shared = false; // m_constants is visible to other contexts and must not be modified
 };
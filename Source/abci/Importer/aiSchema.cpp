@@ -20,6 +20,11 @@ const aiConfig & aiSample::getConfig() const
     return m_schema->getConfig();
 }
 
+size_t aiSample::getMemoryUsage() const
+{
+    return 0;
+}
+
 aiSchema::aiSchema(aiObject *parent, const abcObject &abc)
     : super(parent->getContext(), parent, abc)
 {
@@ -30,17 +35,30 @@ aiSchema::~aiSchema()
     m_properties.clear();
 }
 
-bool aiSchema::isConstant() const { return m_constant; }
+void aiSchema::setup() const
+{
+    // only fills in what is derived from the archive. so this is const as seen from outside.
+    std::call_once(m_setup_once, [this]() { const_cast<aiSchema*>(this)->setupBody(); });
+}
+
+void aiSchema::setupBody()
+{
+    setupProperties();
+}
+
+bool aiSchema::isConstant() const { setup(); return m_constant; }
 bool aiSchema::isDataUpdated() const { return m_data_updated; }
 void aiSchema::markForceUpdate() { m_force_update = true; }
 
 int aiSchema::getNumProperties() const
 {
+    setup();
     return static_cast<int>(m_properties.size());
 }
 
 aiProperty* aiSchema::getPropertyByIndex(int i)
 {
+    setup();
     auto& r = m_properties[i];
     if (r != nullptr) { r->setActive(true); }
     return r.get();
@@ -48,6 +66,7 @@ aiProperty* aiSchema::getPropertyByIndex(int i)
 
 aiProperty* aiSchema::getPropertyByName(const std::string& name)
 {
+    setup();
     auto i = std::lower_bound(m_properties.begin(), m_properties.end(), name,
         [](const aiPropertyPtr& a, const std::string& name) { return a->getName() < name; });
     if (i != m_properties.end())
@@ -9,6 +9,9 @@ public:
     virtual aiSchema* getSchema() const { return m_schema; }
     const aiConfig& getConfig() const;
 
+    // heap memory held by the cooked data. used for the budget of the sample cache.
+    virtual size_t getMemoryUsage() const;
+
 public:
     bool visibility = true;
 
@@ -26,6 +29,9 @@ public:
     aiSchema(aiObject *parent, const abcObject &abc);
     virtual ~aiSchema();
 
+    // runs the expensive part of the initialization (property scan, summary) on first use
+    void setup() const;
+
     bool isConstant() const;
     bool isDataUpdated() const;
     void markForceUpdate();
@@ -34,12 +40,19 @@ public:
     aiProperty* getPropertyByIndex(int i);
     aiProperty* getPropertyByName(const std::string& name);
 
+    // reads and cooks all samples ahead of time (aiConfig::prebake_samples).
+    // returns the memory held by the baked samples in bytes.
+    virtual size_t bakeSamples() = 0;
+    virtual int getNumBakedSamples() const = 0;
+
 protected:
     virtual abcProperties getAbcProperties() = 0;
+    virtual void setupBody();
     void setupProperties();
     void updateProperties(const abcSampleSelector& ss);
 
 protected:
+    mutable std::once_flag m_setup_once;
     bool m_constant = false;
     bool m_data_updated = false;
     bool m_force_update = false;
@@ -69,8 +82,11 @@ public:
 
         m_visibility_prop = AbcGeom::GetVisibilityProperty(const_cast<abcObject&>(abc));
         m_constant = m_schema.isConstant() && (!m_visibility_prop.valid() || m_visibility_prop.isConstant());
+    }
 
-        setupProperties();
+    ~aiTSchema() override
+    {
+        clearSampleCache();
     }
 
     int getTimeSamplingIndex() const
@@ -105,6 +121,44 @@ public:
         updateSampleBody(ss);
     }
 
+    size_t bakeSamples() override
+    {
+        m_baked_samples.clear();
+        setup();
+        // constant schemas have only one sample. the regular path is enough for them.
+        if (!m_enabled || m_constant)
+            return 0;
+
+        waitPrefetch();
+        clearSampleCache();
+
+        // cooking reads these. make each sample be cooked as a fresh read at its index time.
+        m_sample_index_changed = true;
+        m_force_update_local = false;
+        m_current_time_offset = 0.0f;
+
+        // fill a local list so that a failure leaves no partially baked state behind
+        size_t ret = 0;
+        std::vector<SamplePtr> samples((size_t)m_num_samples);
+        for (int64_t i = 0; i < m_num_samples; ++i)
+        {
+            SamplePtr sample(newSample());
+            sample->visibility = readVisibility(aiIndexToSampleSelector(i)) != 0;
+            readSampleBody(*sample, i);
+            cookSampleBody(*sample);
+            onSampleStored(*sample);
+            ret += sizeof(Sample) + sample->getMemoryUsage();
+            samples[i] = sample;
+        }
+        m_baked_samples.swap(samples);
+        return ret;
+    }
+
+    int getNumBakedSamples() const override
+    {
+        return (int)m_baked_samples.size();
+    }
+
     virtual void readSample(Sample& sample, uint64_t idx)
     {
         m_force_update_local = m_force_update;
@@ -116,27 +170,111 @@ public:
         cookSampleBody(sample);
     }
 
+    // reads sample idx into the prefetch slot on the task pool.
+    // it is consumed by updateSampleBody() if the next update hits that index.
+    void prefetchSample(int64_t idx)
+    {
+        waitPrefetch();
+        if (!m_prefetch_sample)
+            m_prefetch_sample.reset(newSample());
+        m_prefetch_index = idx;
+        m_force_update_local = false;
+
+        auto sample = m_prefetch_sample.get();
+        m_prefetch_task.run([this, sample, idx]() { readSampleBody(*sample, idx); });
+    }
+
+    // must be called from the destructor of derived classes as the prefetch task calls their readSampleBody()
+    void waitPrefetch()
+    {
+        try
+        {
+            m_prefetch_task.wait();
+        }
+        catch (...)
+        {
+            // discard. the sample will be read again on the calling thread.
+            m_prefetch_index = -1;
+        }
+    }
+
 
 protected:
     virtual void updateSampleBody(const abcSampleSelector& ss)
     {
         if (!m_enabled)
             return;
+        setup();
 
         Sample* sample = nullptr;
         int64_t sample_index = getSampleIndex(ss);
         auto& config = getConfig();
 
+        // readSampleBody() of the prefetch task may touch the schema's states
+        waitPrefetch();
+
+        bool baked = !m_baked_samples.empty();
+        bool use_cache = !baked && config.sample_cache_size > 0 && !m_constant;
+        if (!use_cache || m_force_update)
+            clearSampleCache();
+
         auto visible = readVisibility(ss) != 0;
         auto updateVisibility = m_sample && m_sample->visibility != visible;
-        if (!m_sample || (!m_constant && sample_index != m_last_sample_index) || m_force_update ||
+
+        SamplePtr prev_sample = m_sample;
+        bool cache_hit = false;
+        if (baked)
+        {
+            // baked samples are already cooked with the current config. a forced update just shows one of them again.
+            // (re-reading would also rebuild the constant data the baked samples refer to)
+            if (!m_sample || sample_index != m_last_sample_index || m_force_update)
+            {
+                m_sample = m_baked_samples[std::min<size_t>((size_t)sample_index, m_baked_samples.size() - 1)];
+                cache_hit = true;
+                if (prev_sample && prev_sample != m_sample)
+                    onSampleStored(*prev_sample);
+            }
+        }
+        else if (use_cache && m_sample && sample_index != m_last_sample_index && !m_force_update && !updateVisibility)
+        {
+            // keep the sample of the index we are leaving and look for the one we are going to
+            storeSampleToCache(m_last_sample_index, m_sample);
+            m_sample = takeSampleFromCache(sample_index);
+            cache_hit = m_sample != nullptr;
+        }
+
+        if (cache_hit)
+        {
+            onSampleRestored(*m_sample, prev_sample.get());
+
+            // already cooked. only the interpolation has to be redone.
+            m_sample_index_changed = false;
+            sample = m_sample.get();
+            if (!config.interpolate_samples)
+                sample = nullptr;
+        }
+        else if (!m_sample || (!m_constant && sample_index != m_last_sample_index) || m_force_update ||
                 updateVisibility)
         {
             m_sample_index_changed = true;
             if (!m_sample)
-                m_sample.reset(newSample());
+            {
+                // a cache miss. read into the sample evicted last rather than allocating all buffers again
+                if (m_spare_sample && recycleSample(*m_spare_sample))
+                {
+                    m_sample = m_spare_sample;
+                    m_sample->visibility = true; // as a new sample
+                }
+                else
+                {
+                    m_sample.reset(newSample());
+                }
+                m_spare_sample.reset();
+            }
             sample = m_sample.get();
-            readSample(*sample, sample_index);
+            if (m_force_update || m_prefetch_index != sample_index || !swapReadData(*sample, *m_prefetch_sample))
+                readSample(*sample, sample_index);
+            m_prefetch_index = -1;
         }
         else
         {
@@ -180,17 +318,91 @@ protected:
         }
         else
         {
-            m_data_updated = false;
+            m_data_updated = cache_hit;
         }
         updateProperties(ss);
 
         m_last_sample_index = sample_index;
         m_force_update = false;
+
+        if (config.prefetch_samples && !baked && (m_sample_index_changed || cache_hit) && !m_constant && sample_index + 1 < m_num_samples &&
+                m_cached_samples.find(sample_index + 1) == m_cached_samples.end())
+            prefetchSample(sample_index + 1);
+    }
+
+    void storeSampleToCache(int64_t idx, const SamplePtr& sample)
+    {
+        auto ctx = getContext();
+        auto& entry = m_cached_samples[idx];
+        if (entry.sample)
+            ctx->addSampleCacheUsage(-(int64_t)entry.size, -1);
+        entry.sample = sample;
+        onSampleStored(*sample);
+        entry.size = sizeof(Sample) + sample->getMemoryUsage();
+        entry.last_use = ++m_cache_clock;
+        ctx->addSampleCacheUsage((int64_t)entry.size, 1);
+
+        // the budget is shared by all schemas of the context. evict our least recently used samples while it is exceeded.
+        int64_t budget = (int64_t)getConfig().sample_cache_size * 1024 * 1024;
+        while (ctx->getSampleCacheUsage() > budget && !m_cached_samples.empty())
+        {
+            auto lru = std::min_element(m_cached_samples.begin(), m_cached_samples.end(),
+                [](const typename CachedSamples::value_type& a, const typename CachedSamples::value_type& b) {
+                    return a.second.last_use < b.second.last_use; });
+            ctx->addSampleCacheUsage(-(int64_t)lru->second.size, -1);
+            if (lru->second.sample.use_count() == 1)
+                m_spare_sample = lru->second.sample;
+            m_cached_samples.erase(lru);
+        }
+    }
+
+    SamplePtr takeSampleFromCache(int64_t idx)
+    {
+        auto ctx = getContext();
+        auto it = m_cached_samples.find(idx);
+        if (it == m_cached_samples.end())
+        {
+            ctx->countSampleCacheAccess(false);
+            return nullptr;
+        }
+
+        SamplePtr ret = it->second.sample;
+        ctx->addSampleCacheUsage(-(int64_t)it->second.size, -1);
+        m_cached_samples.erase(it);
+        ctx->countSampleCacheAccess(true);
+        return ret;
+    }
+
+    void clearSampleCache()
+    {
+        m_spare_sample.reset();
+        if (m_cached_samples.empty())
+            return;
+
+        auto ctx = getContext();
+        for (auto& kvp : m_cached_samples)
+            ctx->addSampleCacheUsage(-(int64_t)kvp.second.size, -1);
+        m_cached_samples.clear();
     }
 
     virtual void readSampleBody(Sample& sample, uint64_t idx) = 0;
     virtual void cookSampleBody(Sample& sample) = 0;
 
+    // called when an already cooked sample (cached or baked) becomes the current one.
+    // prev is the sample that was current before. null on the first update.
+    virtual void onSampleRestored(Sample& sample, const Sample *prev) {}
+
+    // called when a cooked sample is put aside in the cache or the baked samples. it may be compacted.
+    virtual void onSampleStored(Sample& sample) {}
+
+    // called before a sample evicted from the cache is read into again (for another index).
+    // returns false if it can't be reused, then a new one is made.
+    virtual bool recycleSample(Sample& sample) { return false; }
+
+    // swaps the data written by readSampleBody() (array samples etc.) between two samples.
+    // data produced by cookSampleBody() must stay in place.
+    virtual bool swapReadData(Sample& dst, Sample& src) = 0;
+
 
     AbcGeom::ICompoundProperty getAbcProperties() override
     {
@@ -221,4 +433,23 @@ protected:
     bool m_sample_index_changed = false;
 
     bool m_force_update_local = false; // m_force_update for worker thread
+
+    SamplePtr m_prefetch_sample;
+    int64_t m_prefetch_index = -1;
+    aiTaskGroup m_prefetch_task;
+
+    // cooked samples of recently visited indices (aiConfig::sample_cache_size)
+    struct CachedSample
+    {
+        SamplePtr sample;
+        size_t size = 0;
+        uint64_t last_use = 0;
+    };
+    using CachedSamples = std::map<int64_t, CachedSample>;
+    CachedSamples m_cached_samples;
+    uint64_t m_cache_clock = 0;
+    SamplePtr m_spare_sample; // the last sample evicted from the cache. see recycleSample()
+
+    // all samples cooked at load time (aiConfig::prebake_samples). indexed by sample index.
+    std::vector<SamplePtr> m_baked_samples;
 };
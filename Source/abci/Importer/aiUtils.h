@@ -8,3 +8,50 @@ inline void Assign(RawVector<T>& dst, const U& src, int point_count)
 	auto dst_data = dst.data();
 	memcpy(dst_data, src_data, point_count * sizeof(T));
 }
+
+// total bytes reserved by the given vectors
+inline size_t GetMemoryUsage()
+{
+    return 0;
+}
+
+template<class T, class... Rest>
+inline size_t GetMemoryUsage(const RawVector<T>& v, const Rest&... rest)
+{
+    return v.capacity() * sizeof(T) + GetMemoryUsage(rest...);
+}
+
+// 64 bit hash of a memory block (MurmurHash64A). chain calls by passing the previous result as seed.
+inline uint64_t HashMemory(const void *data, size_t size, uint64_t seed = 0)
+{
+    const uint64_t m = 0xc6a4a7935bd1e995ull;
+    const int r = 47;
+
+    uint64_t h = seed ^ (size * m);
+    auto *src = (const uint8_t*)data;
+    size_t n = size / 8;
+    for (size_t i = 0; i < n; ++i)
+    {
+        uint64_t k;
+        memcpy(&k, src + i * 8, 8);
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+
+    size_t rest = size & 7;
+    if (rest)
+    {
+        uint64_t k = 0;
+        memcpy(&k, src + n * 8, rest);
+        h ^= k;
+        h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
@@ -21,6 +21,11 @@ aiXform::aiXform(aiObject *parent, const abcObject &abc)
 {
 }
 
+aiXform::~aiXform()
+{
+    waitPrefetch();
+}
+
 aiXform::Sample* aiXform::newSample()
 {
     return new Sample(this);
@@ -35,6 +40,13 @@ void aiXform::readSampleBody(Sample& sample, uint64_t idx)
     m_schema.get(sample.xf_sp2, ss2);
 }
 
+bool aiXform::swapReadData(Sample& dst, Sample& src)
+{
+    std::swap(dst.xf_sp, src.xf_sp);
+    std::swap(dst.xf_sp2, src.xf_sp2);
+    return true;
+}
+
 void aiXform::cookSampleBody(Sample& sample)
 {
     auto& config = getConfig();
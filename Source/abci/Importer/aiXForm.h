@@ -25,9 +25,11 @@ class aiXform : public aiTSchema<aiXformTraits>
     using super = aiTSchema<aiXformTraits>;
 public:
     aiXform(aiObject *parent, const abcObject &abc);
+    ~aiXform() override;
 
     Sample* newSample() override;
     void readSampleBody(Sample& sample, uint64_t idx) override;
     void cookSampleBody(Sample& sample) override;
+    bool swapReadData(Sample& dst, Sample& src) override;
     void decompose(const Imath::M44d &mat, Imath::V3d &scale, Imath::V3d &shear, Imath::Quatd &rotation, Imath::V3d &translation) const;
 };
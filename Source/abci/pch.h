@@ -9,6 +9,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <future>
+#include <chrono>
 #include <functional>
 #include <limits>
 #include <sstream>
@@ -109,6 +109,8 @@ namespace UnityEditor.Formats.Alembic.Importer
             {
                 EditorGUI.indentLevel++;
                 DisplayEnumProperty(serializedObject.FindProperty(pathSettings + "normals"), Enum.GetNames(typeof(NormalsMode)));
+                DisplayEnumProperty(serializedObject.FindProperty(pathSettings + "normalsWeighting"), Enum.GetNames(typeof(NormalsWeighting)));
+                EditorGUILayout.PropertyField(serializedObject.FindProperty(pathSettings + "smoothingAngle"));
                 DisplayEnumProperty(serializedObject.FindProperty(pathSettings + "tangents"), Enum.GetNames(typeof(TangentsMode)));
                 EditorGUILayout.PropertyField(serializedObject.FindProperty(pathSettings + "flipFaces"));
                 EditorGUI.indentLevel--;
@@ -258,6 +258,9 @@ namespace UnityEditor.Formats.Alembic.Importer
                 EditorGUI.indentLevel++;
                 AlembicImporterEditor.DisplayEnumProperty(settings.FindPropertyRelative("normals"),
                     Enum.GetNames(typeof(NormalsMode)));
+                AlembicImporterEditor.DisplayEnumProperty(settings.FindPropertyRelative("normalsWeighting"),
+                    Enum.GetNames(typeof(NormalsWeighting)));
+                EditorGUILayout.PropertyField(settings.FindPropertyRelative("smoothingAngle"));
                 AlembicImporterEditor.DisplayEnumProperty(settings.FindPropertyRelative("tangents"),
                     Enum.GetNames(typeof(TangentsMode)));
                 EditorGUILayout.PropertyField(settings.FindPropertyRelative("flipFaces"));
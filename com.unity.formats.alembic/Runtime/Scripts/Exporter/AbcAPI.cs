@@ -355,7 +355,13 @@ namespace UnityEngine.Formats.Alembic.Sdk
         [DllImport(Abci.Lib)] public static extern aiContext aiContextCreate(int uid);
         [DllImport(Abci.Lib)] public static extern void aiContextDestroy(IntPtr ctx);
         [DllImport(Abci.Lib, BestFitMapping = false, ThrowOnUnmappableChar = true)] public static extern Bool aiContextLoad(IntPtr ctx, string path);
+        [DllImport(Abci.Lib, BestFitMapping = false, ThrowOnUnmappableChar = true)] public static extern void aiContextLoadAsync(IntPtr ctx, string path);
+        [DllImport(Abci.Lib)] public static extern aiLoadState aiContextGetLoadState(IntPtr ctx);
+        [DllImport(Abci.Lib)] public static extern int aiContextGetLoadProgress(IntPtr ctx);
+        [DllImport(Abci.Lib)] public static extern Bool aiContextWaitLoad(IntPtr ctx);
         [DllImport(Abci.Lib)] public static extern void aiContextSetConfig(IntPtr ctx, ref aiConfig conf);
+        [DllImport(Abci.Lib)] public static extern void aiContextGetSampleCacheStats(IntPtr ctx, ref aiSampleCacheStats dst);
+        [DllImport(Abci.Lib)] public static extern void aiContextGetBakeStats(IntPtr ctx, ref aiBakeStats dst);
         [DllImport(Abci.Lib)] public static extern int aiContextGetTimeSamplingCount(IntPtr ctx);
         [DllImport(Abci.Lib)] public static extern aiTimeSampling aiContextGetTimeSampling(IntPtr ctx, int i);
         [DllImport(Abci.Lib)] public static extern void aiContextGetTimeRange(IntPtr ctx, out double begin, out double end);
@@ -390,6 +396,8 @@ namespace UnityEngine.Formats.Alembic.Sdk
         [DllImport(Abci.Lib, BestFitMapping = false, ThrowOnUnmappableChar = true)] public static extern aiProperty aiSchemaGetPropertyByName(IntPtr schema, string name);
 
         [DllImport(Abci.Lib)] public static extern void aiPolyMeshGetSummary(IntPtr schema, ref aiMeshSummary dst);
+        [DllImport(Abci.Lib)] public static extern void aiPolyMeshGetSkipStats(IntPtr schema, ref aiMeshSkipStats dst);
+        [DllImport(Abci.Lib)] public static extern void aiPolyMeshSetDestinationBuffers(IntPtr schema, IntPtr vbs, int splitCount);
 
         [DllImport(Abci.Lib)] public static extern void aiPointsSetSort(IntPtr schema, Bool v);
         [DllImport(Abci.Lib)] public static extern void aiPointsSetSortBasePosition(IntPtr schema, Vector3 v);
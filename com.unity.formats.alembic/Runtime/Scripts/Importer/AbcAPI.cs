@@ -31,6 +31,21 @@ namespace UnityEngine.Formats.Alembic.Sdk
         //None
     }
 
+    /// <summary>
+    /// How computed normals weight the faces around each vertex.
+    /// </summary>
+    public enum NormalsWeighting
+    {
+        /// <summary>
+        /// Weight faces by their area.
+        /// </summary>
+        Area,
+        /// <summary>
+        /// Weight faces by the angle of the polygon at the vertex.
+        /// </summary>
+        Angle,
+    }
+
     /// <summary>
     /// The tangents processing mode on Alembic file import.
     /// </summary>
@@ -44,6 +59,10 @@ namespace UnityEngine.Formats.Alembic.Sdk
         /// Compute and set mesh tangents. Requires normals and UV data.
         /// </summary>
         Calculate,
+        /// <summary>
+        /// Compute MikkTSpace compatible tangents, matching normal maps baked by MikkTSpace based tools. Requires normals and UV data.
+        /// </summary>
+        MikkTSpace,
     }
 
     enum aiTopologyVariance
@@ -61,6 +80,14 @@ namespace UnityEngine.Formats.Alembic.Sdk
         Quads,
     };
 
+    enum aiLoadState
+    {
+        None,
+        Loading,
+        Succeeded,
+        Failed,
+    }
+
     enum aiPropertyType
     {
         Unknown,
@@ -107,6 +134,21 @@ namespace UnityEngine.Formats.Alembic.Sdk
         public Bool importPointPolygon { get; set; }
         public Bool importLinePolygon { get; set; }
         public Bool importTrianglePolygon { get; set; }
+        public Bool parallelUpdate { get; set; }
+        public Bool prefetchSamples { get; set; }
+        public Bool useMmap { get; set; }
+        public int streamCount { get; set; }
+        public Bool shareArchives { get; set; }
+        public Bool lazyLoad { get; set; }
+        public int sampleCacheSize { get; set; }
+        public Bool prebakeSamples { get; set; }
+        public Bool compressCachedSamples { get; set; }
+        public Bool detectConstantTopology { get; set; }
+        public Bool skipUnchangedAttributes { get; set; }
+        public int topologyCacheSize { get; set; }
+        public NormalsWeighting normalsWeighting { get; set; }
+        public float smoothingAngle { get; set; }
+        public Bool directWrite { get; set; }
 
         public void SetDefaults()
         {
@@ -126,6 +168,21 @@ namespace UnityEngine.Formats.Alembic.Sdk
             importPointPolygon = true;
             importLinePolygon = true;
             importTrianglePolygon = true;
+            parallelUpdate = false;
+            prefetchSamples = false;
+            useMmap = false;
+            streamCount = 1;
+            shareArchives = false;
+            lazyLoad = false;
+            sampleCacheSize = 0;
+            prebakeSamples = false;
+            compressCachedSamples = false;
+            detectConstantTopology = false;
+            skipUnchangedAttributes = false;
+            topologyCacheSize = 0;
+            normalsWeighting = NormalsWeighting.Area;
+            smoothingAngle = 180.0f;
+            directWrite = false;
         }
     }
 
@@ -315,6 +372,41 @@ namespace UnityEngine.Formats.Alembic.Sdk
 #endif
     }
 
+    [StructLayout(LayoutKind.Sequential)]
+    struct aiSampleCacheStats
+    {
+        public long hits;
+        public long misses;
+        public long memoryUsage;
+        public int sampleCount;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    struct aiBakeStats
+    {
+        public double bakeTime;
+        public long memoryUsage;
+        public int sampleCount;
+        public int schemaCount;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    struct aiMeshSkipStats
+    {
+        public long pointsReadSkips;
+        public long pointsRemapSkips;
+        public long normalsReadSkips;
+        public long normalsRemapSkips;
+        public long uv0ReadSkips;
+        public long uv0RemapSkips;
+        public long uv1ReadSkips;
+        public long uv1RemapSkips;
+        public long rgbaReadSkips;
+        public long rgbaRemapSkips;
+        public long rgbReadSkips;
+        public long rgbRemapSkips;
+    }
+
     struct aiContext
     {
         [NativeDisableUnsafePtrRestriction]
@@ -338,6 +430,16 @@ namespace UnityEngine.Formats.Alembic.Sdk
             return NativeMethods.aiContextLoad(self, fullPath);
         }
 
+        public void LoadAsync(string path)
+        {
+            var fullPath = Path.GetFullPath(path);
+            NativeMethods.aiContextLoadAsync(self, fullPath);
+        }
+
+        public aiLoadState loadState { get { return NativeMethods.aiContextGetLoadState(self); } }
+        public int loadProgress { get { return NativeMethods.aiContextGetLoadProgress(self); } }
+        public bool WaitLoad() { return NativeMethods.aiContextWaitLoad(self); }
+
         public bool IsHDF5()
         {
             return NativeMethods.aiContextGetIsHDF5(self);
@@ -350,6 +452,8 @@ namespace UnityEngine.Formats.Alembic.Sdk
         public int timeSamplingCount { get { return NativeMethods.aiContextGetTimeSamplingCount(self); } }
         public aiTimeSampling GetTimeSampling(int i) { return NativeMethods.aiContextGetTimeSampling(self, i); }
         internal void GetTimeRange(out double begin, out double end) { NativeMethods.aiContextGetTimeRange(self, out begin, out end); }
+        internal void GetSampleCacheStats(ref aiSampleCacheStats dst) { NativeMethods.aiContextGetSampleCacheStats(self, ref dst); }
+        internal void GetBakeStats(ref aiBakeStats dst) { NativeMethods.aiContextGetBakeStats(self, ref dst); }
     }
 
     struct aiTimeSampling
@@ -437,6 +541,16 @@ namespace UnityEngine.Formats.Alembic.Sdk
 
         public aiPolyMeshSample sample { get { return NativeMethods.aiPolyMesh.aiSchemaGetSample(self); } }
         public void GetSummary(ref aiMeshSummary dst) { NativeMethods.aiPolyMeshGetSummary(self, ref dst); }
+        internal void GetSkipStats(ref aiMeshSkipStats dst) { NativeMethods.aiPolyMeshGetSkipStats(self, ref dst); }
+
+        // the next update interpolates straight into these buffers. they must stay valid until the vertex buffer is filled
+        internal void SetDestinationBuffers(NativeArray<aiPolyMeshData> vbs)
+        {
+            unsafe
+            {
+                NativeMethods.aiPolyMeshSetDestinationBuffers(self, new IntPtr(vbs.GetUnsafeReadOnlyPtr()), vbs.Length);
+            }
+        }
     }
 
     [StructLayout(LayoutKind.Explicit)]
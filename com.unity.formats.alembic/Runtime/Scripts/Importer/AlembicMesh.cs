@@ -162,6 +162,19 @@ namespace UnityEngine.Formats.Alembic.Importer
             m_abcSchema.GetSummary(ref m_summary);
         }
 
+        public override void AbcPrepareSample()
+        {
+            if (disposed || !m_splitData.IsCreated || m_splitData.Length == 0 || !abcTreeNode.stream.config.directWrite)
+                return;
+
+            // let the update interpolate straight into the buffers of the last sync.
+            // nothing else may touch them until they are filled.
+            fillVertexBufferHandle.Complete();
+            for (var i = 0; i < m_PostProcessJobs.Count; ++i)
+                m_PostProcessJobs[i].Complete();
+            m_abcSchema.SetDestinationBuffers(m_splitData);
+        }
+
         public override unsafe void AbcSyncDataBegin()
         {
             if (disposed || !m_abcSchema.schema.isDataUpdated)
@@ -193,6 +206,7 @@ namespace UnityEngine.Formats.Alembic.Importer
                 split.active = true;
 
                 int vertexCount = m_splitSummaries[spi].vertexCount;
+                vertexData.vertexCount = vertexCount;
 
                 if (!m_summary.constantPoints || topologyChanged)
                     split.points.ResizeIfNeeded(vertexCount);
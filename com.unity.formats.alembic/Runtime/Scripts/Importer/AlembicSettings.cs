@@ -19,6 +19,29 @@ namespace UnityEngine.Formats.Alembic.Importer
             set { normals = value; }
         }
 
+        [SerializeField]
+        NormalsWeighting normalsWeighting = NormalsWeighting.Area;
+        /// <summary>
+        /// Get or set how computed normals weight the faces around each vertex.
+        /// </summary>
+        public NormalsWeighting NormalsWeighting
+        {
+            get { return normalsWeighting; }
+            set { normalsWeighting = value; }
+        }
+
+        [SerializeField]
+        [Range(0.0f, 180.0f)]
+        float smoothingAngle = 180.0f;
+        /// <summary>
+        /// Get or set the angle in degrees above which edges get hard (split) computed normals. 180 smooths all edges.
+        /// </summary>
+        public float SmoothingAngle
+        {
+            get { return smoothingAngle; }
+            set { smoothingAngle = value; }
+        }
+
         [SerializeField]
         TangentsMode tangents = TangentsMode.Calculate;
         /// <summary>
@@ -209,6 +209,8 @@ namespace UnityEngine.Formats.Alembic.Importer
             m_config.aspectRatio = GetAspectRatio(settings.CameraAspectRatio);
             m_config.scaleFactor = settings.ScaleFactor;
             m_config.normalsMode = settings.Normals;
+            m_config.normalsWeighting = settings.NormalsWeighting;
+            m_config.smoothingAngle = settings.SmoothingAngle;
             m_config.tangentsMode = settings.Tangents;
             m_config.interpolateSamples = settings.InterpolateSamples;
             m_config.importPointPolygon = settings.ImportPointPolygon;